@@ -0,0 +1,295 @@
+// Бенчмарк этапов task1_zmq на синтетических данных: загрузка каталога (в том числе через кэш
+// и через отсортированные прогоны на диске), разбор, объединение дубликатов, кодирование и декодирование
+// фрагментов, сортировка и вывод списка.
+// Каждый результат - одна строка "этап ключ=значение ...", пригодная для разбора скриптом.
+// Пример: bench -n 2000000 --duplicates 0.2 --invalid 0.01 --threads 8
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "CLI/CLI.hpp"
+#include "data_loader.hpp"
+#include "external_sort.hpp"
+#include "kway_merge.hpp"
+#include "listing_writer.hpp"
+#include "mapped_file.hpp"
+#include "student_generator.hpp"
+#include "wire_format.hpp"
+
+namespace
+{
+    namespace fs = std::filesystem;
+
+    using Clock = std::chrono::steady_clock;
+
+    double elapsed_ms(Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    // Строка результата: stage name=value ... time_ms=... items_per_sec=...
+    class Result
+    {
+    public:
+        explicit Result(std::string stage) { out_ << std::left << std::setw(18) << stage; }
+
+        template <typename T>
+        Result& field(const char* name, const T& value) {
+            out_ << ' ' << name << '=' << value;
+            return *this;
+        }
+
+        void print(double time_ms, size_t items) {
+            out_ << std::fixed << std::setprecision(2) << " time_ms=" << time_ms
+                << std::setprecision(0) << " items_per_sec=" << (time_ms > 0 ? items / (time_ms / 1000.0) : 0.0);
+            std::cout << out_.str() << std::endl;
+        }
+
+    private:
+        std::ostringstream out_;
+    };
+
+    // Сообщения об отбракованных строках не выводятся: в замер попадает разбор, а не консоль
+    class SilenceCerr
+    {
+    public:
+        SilenceCerr() : saved_(std::cerr.rdbuf(nullptr)) {}
+        ~SilenceCerr() { std::cerr.rdbuf(saved_); std::cerr.clear(); }
+
+    private:
+        std::streambuf* saved_;
+    };
+
+    std::vector<domain::Student> parse_all(const fs::path& dir, size_t& lines) {
+        std::vector<domain::Student> parsed;
+        for (const auto& entry : fs::directory_iterator(dir)) {
+            if (entry.path().extension() != ".txt") {
+                continue;
+            }
+            data_loader::MappedFile file(entry.path());
+            std::string_view data = file.view();
+            size_t pos = 0;
+            while (pos < data.size()) {
+                size_t eol = data.find('\n', pos);
+                if (eol == std::string_view::npos) {
+                    eol = data.size();
+                }
+                ++lines;
+                if (auto student = data_loader::read_student_from_line(data.substr(pos, eol - pos))) {
+                    parsed.push_back(std::move(*student));
+                }
+                pos = eol + 1;
+            }
+        }
+        return parsed;
+    }
+}
+
+int main(int argc, char** argv) {
+    CLI::App app{ "bench - task1_zmq stage benchmarks" };
+
+    bench::GeneratorOptions generator;
+    std::string data_dir;
+    size_t threads = 0;
+    size_t chunk_size = 10000;
+    bool keep = false;
+
+    app.add_option("-n,--lines", generator.lines, "Generated lines (default 1000000)");
+    app.add_option("--files", generator.files, "Generated files (default 4)")->check(CLI::PositiveNumber);
+    app.add_option("--duplicates", generator.duplicate_ratio, "Share of duplicate keys (default 0.1)")
+        ->check(CLI::Range(0.0, 1.0));
+    app.add_option("--invalid", generator.invalid_ratio, "Share of malformed lines (default 0.01)")
+        ->check(CLI::Range(0.0, 1.0));
+    app.add_option("--seed", generator.seed, "Random seed (default 42)");
+    app.add_option("-d,--dir", data_dir, "Use an existing data directory instead of generating one");
+    app.add_option("--threads", threads, "Loader threads for the parallel run (default 0 = all cores)");
+    app.add_option("--chunk-size", chunk_size, "Records per encoded chunk (default 10000)")->check(CLI::PositiveNumber);
+    app.add_flag("--keep", keep, "Keep the generated directory");
+
+    try {
+        app.parse(argc, argv);
+    }
+    catch (const CLI::ParseError& e) {
+        return app.exit(e);
+    }
+
+    try {
+        fs::path dir = data_dir;
+        const bool generated = data_dir.empty();
+        if (generated) {
+            dir = fs::temp_directory_path() / "task1_zmq_bench";
+            fs::remove_all(dir);
+            auto start = Clock::now();
+            const auto result = bench::generate_students(dir, generator);
+            Result("generate")
+                .field("lines", result.lines)
+                .field("unique", result.unique)
+                .field("duplicates", result.duplicates)
+                .field("invalid", result.invalid)
+                .field("bytes", result.bytes)
+                .print(elapsed_ms(start), result.lines);
+        }
+
+        // Полная загрузка каталога: чтение, разбор и объединение
+        data_loader::StudentSet students;
+        const size_t parallel_threads = threads == 0 ? std::max(1u, std::thread::hardware_concurrency()) : threads;
+        for (size_t t : { size_t{ 1 }, parallel_threads }) {
+            data_loader::LoadOptions options;
+            options.threads = t;
+            data_loader::LoadStats stats;
+            SilenceCerr silence;
+            auto start = Clock::now();
+            students = data_loader::load_all_students(dir.string(), options, &stats);
+            const double ms = elapsed_ms(start);
+            Result("load_all_students")
+                .field("threads", t)
+                .field("lines", stats.lines)
+                .field("rejected", stats.rejected)
+                .field("records", students.size())
+                .print(ms, stats.lines);
+            if (parallel_threads == 1) {
+                break;
+            }
+        }
+
+        // Загрузка с бинарным кэшем: первый прогон разбирает файлы и пишет кэш, второй читает только кэш
+        {
+            data_loader::LoadOptions options;
+            options.threads = parallel_threads;
+            options.use_cache = true;
+            options.cache_path = (fs::temp_directory_path() / "task1_zmq_bench.cache").string();
+            fs::remove(options.cache_path);
+            for (const char* run : { "cold", "warm" }) {
+                data_loader::LoadStats stats;
+                SilenceCerr silence;
+                auto start = Clock::now();
+                students = data_loader::load_all_students(dir.string(), options, &stats);
+                const double ms = elapsed_ms(start);
+                Result("load_cached")
+                    .field("run", run)
+                    .field("threads", parallel_threads)
+                    .field("cached_files", stats.cached_files)
+                    .field("records", students.size())
+                    .print(ms, stats.lines);
+            }
+            fs::remove(options.cache_path);
+        }
+
+        // Загрузка с бюджетом памяти: отсортированные прогоны на диске и k-путевое слияние
+        for (size_t budget_mib : { size_t{ 16 }, size_t{ 256 } }) {
+            data_loader::ExternalOptions options;
+            options.memory_budget = budget_mib << 20;
+            data_loader::LoadStats stats;
+            SilenceCerr silence;
+            auto start = Clock::now();
+            const auto students_file = data_loader::load_all_students_external(dir.string(), options, &stats);
+            const double ms = elapsed_ms(start);
+            Result("load_external")
+                .field("budget_mib", budget_mib)
+                .field("records", students_file.size())
+                .field("bytes", fs::file_size(students_file.path()))
+                .print(ms, stats.lines);
+        }
+
+        // Только разбор строк (без объединения)
+        size_t lines = 0;
+        std::vector<domain::Student> parsed;
+        {
+            SilenceCerr silence;
+            auto start = Clock::now();
+            parsed = parse_all(dir, lines);
+            Result("parse").field("lines", lines).field("accepted", parsed.size()).print(elapsed_ms(start), lines);
+        }
+
+        // Только объединение дубликатов разобранных записей
+        {
+            auto start = Clock::now();
+            data_loader::StudentSet dedup;
+            for (const auto& student : parsed) {
+                dedup.insert(student);
+            }
+            Result("dedup").field("input", parsed.size()).field("records", dedup.size()).print(elapsed_ms(start), parsed.size());
+        }
+        parsed.clear();
+        parsed.shrink_to_fit();
+
+        // Сортировка полного набора
+        std::vector<domain::Student> sorted = students.to_students();
+        {
+            auto start = Clock::now();
+            std::sort(sorted.begin(), sorted.end(), domain::Student::order{});
+            Result("sort").field("records", sorted.size()).print(elapsed_ms(start), sorted.size());
+        }
+
+        for (wire::Format format : { wire::Format::Binary, wire::Format::Json }) {
+            // Кодирование фрагментами, как при подготовке снимка на сервере
+            std::vector<std::string> chunks;
+            size_t bytes = 0;
+            auto start = Clock::now();
+            for (size_t begin = 0; begin < sorted.size(); begin += chunk_size) {
+                const size_t end = std::min(begin + chunk_size, sorted.size());
+                std::vector<domain::Student> chunk(sorted.begin() + begin, sorted.begin() + end);
+                chunks.push_back(wire::encode_students(chunk, format));
+                bytes += chunks.back().size();
+            }
+            Result("serialize")
+                .field("format", wire::format_name(format))
+                .field("records", sorted.size())
+                .field("chunks", chunks.size())
+                .field("bytes", bytes)
+                .print(elapsed_ms(start), sorted.size());
+
+            start = Clock::now();
+            std::vector<std::vector<domain::Student>> runs;
+            runs.reserve(chunks.size());
+            for (const auto& chunk : chunks) {
+                runs.push_back(wire::decode_students(chunk, format));
+            }
+            Result("deserialize")
+                .field("format", wire::format_name(format))
+                .field("records", sorted.size())
+                .field("bytes", bytes)
+                .print(elapsed_ms(start), sorted.size());
+
+            // Слияние отсортированных фрагментов на клиенте
+            if (format == wire::Format::Binary) {
+                start = Clock::now();
+                size_t merged = 0;
+                util::merge_sorted_runs(std::move(runs), domain::Student::order{},
+                    [&](domain::Student&&) { ++merged; });
+                Result("merge_runs").field("records", merged).print(elapsed_ms(start), merged);
+            }
+        }
+
+        // Вывод списка (в /dev/null, чтобы не зависеть от терминала)
+#ifdef _WIN32
+        const std::string null_device = "NUL";
+#else
+        const std::string null_device = "/dev/null";
+#endif
+        for (auto format : { render::OutputFormat::Text, render::OutputFormat::Csv }) {
+            render::ListingWriter writer(null_device, format);
+            auto start = Clock::now();
+            writer.write(sorted);
+            Result("render")
+                .field("format", format == render::OutputFormat::Csv ? "csv" : "text")
+                .field("records", sorted.size())
+                .print(elapsed_ms(start), sorted.size());
+        }
+
+        if (generated && !keep) {
+            fs::remove_all(dir);
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
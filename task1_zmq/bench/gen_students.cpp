@@ -0,0 +1,47 @@
+// Генератор файлов студентов для нагрузочных прогонов сервера и бенчмарков.
+// Пример: gen_students -o /tmp/students -n 5000000 --files 8 --duplicates 0.2 --invalid 0.01
+#include <iostream>
+
+#include "CLI/CLI.hpp"
+#include "student_generator.hpp"
+
+int main(int argc, char** argv) {
+    CLI::App app{ "gen_students - synthetic student files for task1_zmq" };
+
+    std::string dir;
+    bench::GeneratorOptions options;
+
+    app.add_option("-o,--output", dir, "Output directory")->required();
+    app.add_option("-n,--lines", options.lines, "Total number of lines (default 1000000)");
+    app.add_option("--files", options.files, "Number of files to spread lines across (default 4)")
+        ->check(CLI::PositiveNumber);
+    app.add_option("--duplicates", options.duplicate_ratio, "Share of lines repeating an earlier key (default 0.1)")
+        ->check(CLI::Range(0.0, 1.0));
+    app.add_option("--invalid", options.invalid_ratio, "Share of malformed lines (default 0.01)")
+        ->check(CLI::Range(0.0, 1.0));
+    app.add_option("--seed", options.seed, "Random seed (default 42)");
+
+    try {
+        app.parse(argc, argv);
+    }
+    catch (const CLI::ParseError& e) {
+        return app.exit(e);
+    }
+
+    try {
+        const auto result = bench::generate_students(dir, options);
+        std::cout << "generated"
+            << " lines=" << result.lines
+            << " unique=" << result.unique
+            << " duplicates=" << result.duplicates
+            << " invalid=" << result.invalid
+            << " bytes=" << result.bytes
+            << " files=" << options.files
+            << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,137 @@
+// Микробенчмарк разбора строк: прежний разбор через std::regex против
+// однопроходного data_loader::read_student_from_line.
+// Использование: parser_bench [число строк, по умолчанию 1000000]
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "data_loader.hpp"
+
+namespace legacy
+{
+    // Реализация read_student_from_line до перехода на ручной разбор
+    static std::optional<domain::Student> read_student_from_line(const std::string& line) {
+        std::regex student_regex(R"((\d+)\s+([^\d]+)\s+(\d{1,2}\.\d{1,2}\.\d{4})\s*)");
+        std::smatch matches;
+
+        if (std::regex_match(line, matches, student_regex) && matches.size() == 4) {
+            try {
+                uint16_t id = static_cast<uint16_t>(std::stoul(matches[1].str()));
+                std::string fio = matches[2].str();
+                std::string date_str = matches[3].str();
+
+                size_t first = fio.find_first_not_of(' ');
+                size_t last = fio.find_last_not_of(' ');
+                if (first == std::string::npos) {
+                    fio = "";
+                }
+                else {
+                    fio = fio.substr(first, (last - first + 1));
+                }
+
+                std::tm tm = {};
+                std::istringstream date_ss(date_str);
+                date_ss >> std::get_time(&tm, "%d.%m.%Y");
+                if (date_ss.fail()) {
+                    return std::nullopt;
+                }
+
+                std::chrono::year_month_day birth_date = std::chrono::year{ tm.tm_year + 1900 } /
+                    std::chrono::month{ static_cast<unsigned>(tm.tm_mon + 1) } /
+                    std::chrono::day{ static_cast<unsigned>(tm.tm_mday) };
+
+                if (!birth_date.ok() || fio.empty()) {
+                    return std::nullopt;
+                }
+
+                return domain::Student{ id, fio, birth_date };
+            }
+            catch (const std::exception&) {
+                return std::nullopt;
+            }
+        }
+        return std::nullopt;
+    }
+}
+
+namespace
+{
+    const char* const kFirstNames[] = { "Ivan", "Petr", "Denis", "Vladimir", "Sergey", "Anna", "Maria", "Olga" };
+    const char* const kLastNames[] = { "Ivanov", "Petrov", "Denisov", "Jukov", "Kochkin", "Kazakov", "Smirnova", "Orlova" };
+
+    std::filesystem::path write_synthetic_file(size_t line_count) {
+        auto path = std::filesystem::temp_directory_path() / "parser_bench_students.txt";
+        std::ofstream ofs(path, std::ios::binary);
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<int> name(0, 7), day(1, 28), month(1, 12), year(1970, 2005), id(1, 65535);
+
+        for (size_t i = 0; i < line_count; ++i) {
+            // Половина дат с однозначными днём/месяцем, как "04.5.1987"
+            ofs << id(rng) << ' ' << kFirstNames[name(rng)] << ' ' << kLastNames[name(rng)] << ' ';
+            if (i % 2 == 0) {
+                ofs << std::setw(2) << std::setfill('0') << day(rng) << '.'
+                    << std::setw(2) << month(rng) << std::setfill(' ');
+            }
+            else {
+                ofs << day(rng) << '.' << month(rng);
+            }
+            ofs << '.' << year(rng) << '\n';
+        }
+        return path;
+    }
+
+    template <typename Parser>
+    void run(const char* name, const std::vector<std::string>& lines, Parser parser) {
+        size_t accepted = 0;
+        size_t checksum = 0;
+
+        auto start = std::chrono::steady_clock::now();
+        for (const auto& line : lines) {
+            if (auto student = parser(line)) {
+                ++accepted;
+                checksum += student->id + student->fio.size() + static_cast<unsigned>(student->birth_date.day());
+            }
+        }
+        auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << std::left << std::setw(14) << name
+            << " lines=" << lines.size()
+            << " accepted=" << accepted
+            << " checksum=" << checksum
+            << " time_ms=" << std::fixed << std::setprecision(1) << elapsed
+            << " lines_per_sec=" << std::setprecision(0) << (lines.size() / (elapsed / 1000.0))
+            << std::endl;
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t line_count = 1'000'000;
+    if (argc > 1) {
+        line_count = std::stoul(argv[1]);
+    }
+
+    auto path = write_synthetic_file(line_count);
+    std::vector<std::string> lines;
+    lines.reserve(line_count);
+    {
+        std::ifstream ifs(path);
+        std::string line;
+        while (std::getline(ifs, line)) {
+            lines.push_back(line);
+        }
+    }
+    std::filesystem::remove(path);
+
+    std::cout << "Synthetic file: " << lines.size() << " lines" << std::endl;
+    run("regex", lines, [](const std::string& line) { return legacy::read_student_from_line(line); });
+    run("single_pass", lines, [](const std::string& line) { return data_loader::read_student_from_line(line); });
+    return 0;
+}
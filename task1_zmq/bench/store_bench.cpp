@@ -0,0 +1,161 @@
+// Сравнение контейнеров набора студентов: прежний
+// std::unordered_set<Student, Student::hash> (с прежней и новой хеш-функцией)
+// против data_loader::StudentStore.
+// Измеряются время вставки, время поиска и память в куче (счётчик operator new).
+// Использование: store_bench [число записей, по умолчанию 10000000]
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "student_store.hpp"
+
+namespace
+{
+    std::atomic<size_t> g_live_bytes{ 0 };
+}
+
+// Размер блока хранится перед ним, чтобы operator delete без размера тоже учитывался
+void* operator new(std::size_t size) {
+    auto* block = static_cast<std::size_t*>(std::malloc(size + sizeof(std::max_align_t)));
+    if (block == nullptr) {
+        throw std::bad_alloc{};
+    }
+    *block = size;
+    g_live_bytes.fetch_add(size, std::memory_order_relaxed);
+    return reinterpret_cast<char*>(block) + sizeof(std::max_align_t);
+}
+
+void operator delete(void* ptr) noexcept {
+    if (ptr == nullptr) {
+        return;
+    }
+    auto* block = reinterpret_cast<std::size_t*>(static_cast<char*>(ptr) - sizeof(std::max_align_t));
+    g_live_bytes.fetch_sub(*block, std::memory_order_relaxed);
+    std::free(block);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    operator delete(ptr);
+}
+
+namespace legacy
+{
+    // Student::hash до перехода на domain::key_hash
+    struct hash {
+        size_t operator()(const domain::Student& s) const {
+            size_t h1 = std::hash<std::string>{}(s.fio);
+            size_t h2 = std::hash<int>{}(static_cast<int>(s.birth_date.year()));
+            size_t h3 = std::hash<unsigned int>{}(static_cast<unsigned int>(s.birth_date.month()));
+            size_t h4 = std::hash<unsigned int>{}(static_cast<unsigned int>(s.birth_date.day()));
+
+            return h1 ^ (h2 << 1) ^ (h3 << 2) ^ (h4 << 3);
+        }
+    };
+}
+
+namespace
+{
+    const char* const kLastNames[] = { "Ivanov", "Petrov", "Denisov", "Jukov", "Kochkin", "Kazakov", "Smirnov", "Orlov",
+        "Sokolov", "Popov", "Lebedev", "Kozlov", "Novikov", "Morozov", "Volkov", "Solovyov" };
+    const char* const kFirstNames[] = { "Ivan", "Petr", "Denis", "Vladimir", "Sergey", "Alexey", "Dmitry", "Andrey",
+        "Mikhail", "Nikolay", "Pavel", "Roman", "Oleg", "Yuri", "Igor", "Konstantin" };
+    const char* const kPatronymics[] = { "Ivanovich", "Petrovich", "Sergeevich", "Alexeevich", "Dmitrievich", "Andreevich",
+        "Mikhailovich", "Nikolaevich", "Pavlovich", "Romanovich", "Olegovich", "Yurievich", "Igorevich", "Borisovich",
+        "Viktorovich", "Fedorovich" };
+
+    // ФИО вида "Фамилия Имя Отчество" (20-30 байт, длиннее SSO-буфера std::string)
+    std::vector<domain::Student> make_students(size_t count) {
+        std::mt19937_64 rng(42);
+        std::uniform_int_distribution<int> name(0, 15), id(1, 65535);
+        std::uniform_int_distribution<int> days(0, 365 * 36);
+        const auto epoch = std::chrono::sys_days{ std::chrono::year{ 1970 } / 1 / 1 };
+
+        std::vector<domain::Student> students;
+        students.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            std::string fio = kLastNames[name(rng)];
+            fio += ' ';
+            fio += kFirstNames[name(rng)];
+            fio += ' ';
+            fio += kPatronymics[name(rng)];
+            students.push_back({ static_cast<uint16_t>(id(rng)), std::move(fio),
+                std::chrono::year_month_day{ epoch + std::chrono::days{ days(rng) } } });
+        }
+        return students;
+    }
+
+    double elapsed_ms(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void report(const char* name, size_t unique, size_t bytes, double insert_ms, double find_ms, size_t found) {
+        std::cout << std::left << std::setw(14) << name
+            << " records=" << unique
+            << " heap_bytes=" << bytes
+            << " bytes_per_record=" << std::fixed << std::setprecision(1) << (static_cast<double>(bytes) / unique)
+            << " insert_ms=" << insert_ms
+            << " find_ms=" << find_ms
+            << " found=" << found
+            << std::endl;
+    }
+
+    template <typename Hash>
+    void bench_unordered_set(const char* name, const std::vector<domain::Student>& students) {
+        const size_t before = g_live_bytes.load();
+        auto start = std::chrono::steady_clock::now();
+        std::unordered_set<domain::Student, Hash> set;
+        for (const auto& student : students) {
+            set.insert(student);
+        }
+        const double insert_ms = elapsed_ms(start);
+        const size_t bytes = g_live_bytes.load() - before;
+
+        start = std::chrono::steady_clock::now();
+        size_t found = 0;
+        for (const auto& student : students) {
+            found += set.count(student);
+        }
+        report(name, set.size(), bytes, insert_ms, elapsed_ms(start), found);
+    }
+
+    void bench_student_store(const std::vector<domain::Student>& students) {
+        const size_t before = g_live_bytes.load();
+        auto start = std::chrono::steady_clock::now();
+        data_loader::StudentStore store;
+        for (const auto& student : students) {
+            store.insert(student);
+        }
+        const double insert_ms = elapsed_ms(start);
+        const size_t bytes = g_live_bytes.load() - before;
+
+        start = std::chrono::steady_clock::now();
+        size_t found = 0;
+        for (const auto& student : students) {
+            found += store.contains(student.fio, student.birth_date);
+        }
+        report("student_store", store.size(), bytes, insert_ms, elapsed_ms(start), found);
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t count = 10'000'000;
+    if (argc > 1) {
+        count = std::stoul(argv[1]);
+    }
+
+    const auto students = make_students(count);
+    std::cout << "Generated: " << students.size() << " records" << std::endl;
+
+    // Каждый контейнер строится и освобождается до запуска следующего
+    bench_unordered_set<legacy::hash>("set_old_hash", students);
+    bench_unordered_set<domain::Student::hash>("set_new_hash", students);
+    bench_student_store(students);
+    return 0;
+}
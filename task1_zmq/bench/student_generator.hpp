@@ -0,0 +1,144 @@
+#pragma once
+// Генератор синтетических файлов студентов для бенчмарков.
+// Каждая строка - либо новая запись, либо повтор уже выданного ключа (ФИО + дата рождения)
+// с другим ID, либо некорректная строка одного из типовых видов.
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace bench
+{
+    struct GeneratorOptions {
+        std::size_t lines = 1'000'000;
+        std::size_t files = 4;
+        double duplicate_ratio = 0.1;   // доля строк, повторяющих уже выданный ключ
+        double invalid_ratio = 0.01;    // доля некорректных строк
+        uint64_t seed = 42;
+    };
+
+    struct GeneratorResult {
+        std::size_t lines = 0;
+        std::size_t unique = 0;         // ожидаемое число записей после объединения
+        std::size_t duplicates = 0;
+        std::size_t invalid = 0;
+        std::size_t bytes = 0;
+    };
+
+    namespace detail {
+        inline const char* const kLastNames[] = { "Ivanov", "Petrov", "Denisov", "Jukov", "Kochkin", "Kazakov",
+            "Smirnov", "Orlov", "Sokolov", "Popov", "Lebedev", "Kozlov", "Novikov", "Morozov",
+            "\xD0\x92\xD0\xBE\xD0\xBB\xD0\xBA\xD0\xBE\xD0\xB2",     // Волков
+            "\xD0\xA1\xD0\xBE\xD0\xBB\xD0\xBE\xD0\xB2\xD1\x8C\xD1\x91\xD0\xB2" };   // Соловьёв
+        inline const char* const kFirstNames[] = { "Ivan", "Petr", "Denis", "Vladimir", "Sergey", "Alexey", "Dmitry",
+            "Andrey", "Mikhail", "Nikolay", "Pavel", "Roman", "Oleg", "Yuri", "Igor", "Konstantin" };
+        inline const char* const kPatronymics[] = { "Ivanovich", "Petrovich", "Sergeevich", "Alexeevich", "Dmitrievich",
+            "Andreevich", "Mikhailovich", "Nikolaevich", "Pavlovich", "Romanovich", "Olegovich", "Yurievich",
+            "Igorevich", "Borisovich", "Viktorovich", "Fedorovich" };
+
+        constexpr std::size_t kNameCount = 16 * 16 * 16;
+        // Даты рождения 1970-01-01 .. 2005-12-31 (дней от эпохи)
+        constexpr int kFirstDay = 0;
+        constexpr int kDayCount = 13149;
+
+        // Ключ с номером k: ФИО и дата однозначно восстанавливаются из k,
+        // поэтому разные k дают разные ключи (до kNameCount * kDayCount записей)
+        inline void append_key(std::string& line, uint64_t k) {
+            const std::size_t name = k % kNameCount;
+            line += kLastNames[name % 16];
+            line += ' ';
+            line += kFirstNames[name / 16 % 16];
+            line += ' ';
+            line += kPatronymics[name / 256];
+            line += ' ';
+
+            const auto ymd = std::chrono::year_month_day{ std::chrono::sys_days{
+                std::chrono::days{ kFirstDay + static_cast<int>(k / kNameCount % kDayCount) } } };
+            const unsigned day = static_cast<unsigned>(ymd.day());
+            const unsigned month = static_cast<unsigned>(ymd.month());
+            // Часть дат без ведущих нулей, как "4.5.1987"
+            if (k % 3 == 0) {
+                line += std::to_string(day) + '.' + std::to_string(month) + '.';
+            }
+            else {
+                line += char('0' + day / 10);
+                line += char('0' + day % 10);
+                line += '.';
+                line += char('0' + month / 10);
+                line += char('0' + month % 10);
+                line += '.';
+            }
+            line += std::to_string(static_cast<int>(ymd.year()));
+        }
+
+        inline std::string invalid_line(std::mt19937_64& rng) {
+            switch (rng() % 6) {
+            case 0: return "12 Ivan Ivanov 31.02.1990";         // несуществующая дата
+            case 1: return "13 Ivan Ivanov 01.13.1990";         // месяц вне диапазона
+            case 2: return "14 01.01.1990";                     // нет ФИО
+            case 3: return "x15 Ivan Ivanov 01.01.1990";        // ID не число
+            case 4: return "16 Ivan Ivanov 1990-01-01";         // другой формат даты
+            default: return "";                                 // пустая строка
+            }
+        }
+    }
+
+    // Создаёт options.files файлов students_NNN.txt в каталоге dir (каталог создаётся при необходимости)
+    inline GeneratorResult generate_students(const std::filesystem::path& dir, const GeneratorOptions& options) {
+        if (options.files == 0) {
+            throw std::invalid_argument("files must be positive");
+        }
+        if (options.lines > detail::kNameCount * detail::kDayCount) {
+            throw std::invalid_argument("too many lines for the unique key space");
+        }
+        std::filesystem::create_directories(dir);
+
+        std::mt19937_64 rng(options.seed);
+        std::uniform_real_distribution<double> chance(0.0, 1.0);
+        std::uniform_int_distribution<int> id(1, 65535);
+
+        GeneratorResult result;
+        std::vector<std::ofstream> files;
+        for (std::size_t f = 0; f < options.files; ++f) {
+            char name[32];
+            std::snprintf(name, sizeof(name), "students_%03zu.txt", f);
+            files.emplace_back(dir / name, std::ios::binary | std::ios::trunc);
+            if (!files.back().is_open()) {
+                throw std::runtime_error("Could not create " + (dir / name).string());
+            }
+        }
+
+        std::string line;
+        for (std::size_t i = 0; i < options.lines; ++i) {
+            line.clear();
+            const double roll = chance(rng);
+            if (roll < options.invalid_ratio) {
+                line = detail::invalid_line(rng);
+                ++result.invalid;
+            }
+            else {
+                uint64_t k;
+                if (result.unique > 0 && roll < options.invalid_ratio + options.duplicate_ratio) {
+                    k = rng() % result.unique;
+                    ++result.duplicates;
+                }
+                else {
+                    k = result.unique++;
+                }
+                line = std::to_string(id(rng)) + ' ';
+                detail::append_key(line, k);
+            }
+            line += '\n';
+            files[i % options.files] << line;
+            result.bytes += line.size();
+            ++result.lines;
+        }
+        return result;
+    }
+}
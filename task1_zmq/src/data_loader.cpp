@@ -1,9 +1,18 @@
 #include "data_loader.hpp"
-#include <regex>
+#include <algorithm>
+#include <atomic>
+#include <charconv>
 #include <iostream>
 #include <fstream>
 #include <filesystem>
-#include <iomanip>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "kway_merge.hpp"
+#include "mapped_file.hpp"
+#include "student_cache.hpp"
+#include "wire_format.hpp"
 
 
 namespace data_loader
@@ -11,94 +20,599 @@ namespace data_loader
     namespace fs = std::filesystem;
     using namespace std::string_literals;
 
-    static std::optional<domain::Student> read_student_from_line(const std::string& line) {
-        // ������: ID + ������� + ��� + ������� + ����
-        // ���������� ������������� ������, �� ��������� �� Unicode-��������
-        std::regex student_regex(R"((\d+)\s+([^\d]+)\s+(\d{1,2}\.\d{1,2}\.\d{4})\s*)");
-        std::smatch matches;
+    // Аналог \s из std::regex для локали "C"
+    static bool is_space(char c) {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+    }
+
+    static bool is_digit(char c) {
+        return c >= '0' && c <= '9';
+    }
+
+    // Читает подряд идущие цифры начиная с pos, возвращает их количество
+    static size_t read_digits(std::string_view s, size_t& pos, unsigned& value) {
+        const size_t begin = pos;
+        value = 0;
+        while (pos < s.size() && is_digit(s[pos])) {
+            value = value * 10 + static_cast<unsigned>(s[pos] - '0');
+            ++pos;
+        }
+        return pos - begin;
+    }
+
+    // Формат: ID + пробелы + ФИО + пробелы + дата (Д.М.ГГГГ или ДД.ММ.ГГГГ) + хвостовые пробелы.
+    // Однопроходный разбор повторяет правила прежнего выражения
+    // (\d+)\s+([^\d]+)\s+(\d{1,2}\.\d{1,2}\.\d{4})\s* без std::regex;
+    // ФИО возвращается как участок исходной строки, без выделения памяти.
+    // Строка не выводится: причина отбраковки сообщается через reason
+    static std::optional<StudentStore::StudentView> parse_student(std::string_view line, RejectReason& reason) {
+        const size_t n = line.size();
+        size_t pos = 0;
+
+        // ID: \d+
+        while (pos < n && is_digit(line[pos])) {
+            ++pos;
+        }
+        const size_t id_end = pos;
+
+        // ФИО не содержит цифр, поэтому первая цифра после ID начинает дату.
+        // Участок между ID и датой обязан начинаться и заканчиваться пробельным символом
+        while (pos < n && !is_digit(line[pos])) {
+            ++pos;
+        }
+        const std::string_view middle = line.substr(id_end, pos - id_end);
+
+        unsigned day = 0, month = 0, year = 0;
+        bool format_ok = id_end > 0 && middle.size() >= 3 && is_space(middle.front()) && is_space(middle.back());
+        if (format_ok) {
+            const size_t day_digits = read_digits(line, pos, day);
+            format_ok = day_digits >= 1 && day_digits <= 2 && pos < n && line[pos++] == '.';
+        }
+        if (format_ok) {
+            const size_t month_digits = read_digits(line, pos, month);
+            format_ok = month_digits >= 1 && month_digits <= 2 && pos < n && line[pos++] == '.';
+        }
+        if (format_ok) {
+            format_ok = read_digits(line, pos, year) == 4;
+        }
+        while (format_ok && pos < n) {
+            format_ok = is_space(line[pos++]);
+        }
+        if (!format_ok) {
+            reason = RejectReason::Format;
+            return std::nullopt;
+        }
+
+        unsigned long raw_id = 0;
+        if (std::from_chars(line.data(), line.data() + id_end, raw_id).ec != std::errc{}) {
+            reason = RejectReason::IdRange;
+            return std::nullopt;
+        }
+        const uint16_t id = static_cast<uint16_t>(raw_id);
+
+        // Ведущие пробелы относятся к разделителю после ID, ровно один
+        // хвостовой - к разделителю перед датой; затем обрезаются пробелы
+        size_t lead = 0;
+        while (lead < middle.size() - 2 && is_space(middle[lead])) {
+            ++lead;
+        }
+        std::string_view fio = middle.substr(lead, middle.size() - 1 - lead);
+        const size_t first = fio.find_first_not_of(' ');
+        const size_t last = fio.find_last_not_of(' ');
+        fio = (first == std::string_view::npos) ? std::string_view{} : fio.substr(first, last - first + 1);
+
+        // Диапазоны полей как у std::get_time("%d.%m.%Y")
+        if (day < 1 || day > 31 || month < 1 || month > 12) {
+            reason = RejectReason::DateRange;
+            return std::nullopt;
+        }
+
+        const std::chrono::year_month_day birth_date = std::chrono::year{ static_cast<int>(year) } /
+            std::chrono::month{ month } /
+            std::chrono::day{ day };
+
+        if (!birth_date.ok()) {
+            reason = RejectReason::DateValue;
+            return std::nullopt;
+        }
+
+        if (fio.empty()) {
+            reason = RejectReason::EmptyFio;
+            return std::nullopt;
+        }
+
+        return StudentStore::StudentView{ id, fio, birth_date };
+    }
+
+    std::optional<domain::Student> read_student_from_line(std::string_view line) {
+        RejectReason reason;
+        if (auto student = parse_student(line, reason)) {
+            return student->to_student();
+        }
+        std::cerr << reject_reason_message(reason) << line << std::endl;
+        return std::nullopt;
+    }
+
+    StudentDelta diff_students(const StudentSet& before, const StudentSet& after) {
+        StudentDelta delta;
+        for (const auto student : after) {
+            auto previous = before.find(student.fio, student.birth_date);
+            if (!previous || previous->id != student.id) {
+                delta.added.push_back(student.to_student());
+            }
+        }
+        for (const auto student : before) {
+            if (!after.contains(student.fio, student.birth_date)) {
+                delta.removed.push_back(student.to_student());
+            }
+        }
+        return delta;
+    }
+
+    void apply_delta(StudentSet& students, const StudentDelta& delta) {
+        for (const auto& student : delta.removed) {
+            students.erase(student);
+        }
+        for (const auto& student : delta.added) {
+            // Запись с тем же ФИО и датой рождения получает новый ID
+            students.insert_or_assign(student);
+        }
+    }
+
+    void accumulate_delta(ListingChanges& changes, const StudentDelta& delta) {
+        for (const auto& student : delta.removed) {
+            changes.insert_or_assign(student, std::nullopt);
+        }
+        for (const auto& student : delta.added) {
+            changes.insert_or_assign(student, student);
+        }
+    }
+
+    std::vector<domain::Student> apply_changes(const std::vector<domain::Student>& sorted, const ListingChanges& changes) {
+        const domain::Student::order less;
+        std::vector<domain::Student> result;
+        result.reserve(sorted.size() + changes.size());
+
+        auto change = changes.begin();
+        auto emit_change = [&] {
+            if (change->second) {
+                result.push_back(*change->second);
+            }
+            ++change;
+        };
+        for (const auto& student : sorted) {
+            while (change != changes.end() && less(change->first, student)) {
+                emit_change();
+            }
+            // Изменение записи с тем же ключом заменяет её или удаляет
+            if (change != changes.end() && !less(student, change->first)) {
+                emit_change();
+            }
+            else {
+                result.push_back(student);
+            }
+        }
+        while (change != changes.end()) {
+            emit_change();
+        }
+        return result;
+    }
+
+    std::vector<domain::Student> merge_listings(const std::vector<const std::vector<domain::Student>*>& listings) {
+        struct ListingSource {
+            const std::vector<domain::Student>* listing;
+            size_t position = 0;
+
+            bool next(domain::Student& student) {
+                if (position == listing->size()) {
+                    return false;
+                }
+                student = (*listing)[position++];
+                return true;
+            }
+        };
+
+        std::vector<ListingSource> sources;
+        size_t total = 0;
+        for (const auto* listing : listings) {
+            sources.push_back({ listing });
+            total += listing->size();
+        }
+
+        // Равные ключи приходят в порядке списков: первая запись побеждает, остальные пропускаются
+        const domain::Student::order less;
+        std::vector<domain::Student> result;
+        result.reserve(total);
+        util::merge_sorted_streams<domain::Student>(sources, less, [&](domain::Student&& student) {
+            if (result.empty() || less(result.back(), student)) {
+                result.push_back(std::move(student));
+            }
+        });
+        return result;
+    }
+
+    std::vector<fs::path> list_student_files(const std::string& dir_path) {
+        std::vector<fs::path> files;
+        for (const auto& entry : fs::directory_iterator(dir_path)) {
+            if (entry.is_regular_file() && entry.path().extension() == ".txt") {
+                files.push_back(entry.path());
+            }
+        }
+        return files;
+    }
+
+    // Учёт отбракованной строки; в журнал она уходит без ожидания записи
+    static void reject_line(LoadStats& stats, RejectReason reason, RejectLog* reject_log,
+        const std::string& file, size_t line_number, std::string_view line) {
+        ++stats.rejected;
+        ++stats.rejected_by_reason[static_cast<size_t>(reason)];
+        if (reject_log) {
+            reject_log->push({ file, line_number, reason, std::string(line) });
+        }
+    }
+
+    // Разбор участка отображённого файла построчно (семантика std::getline);
+    // first_line - номер первой строки участка в файле
+    template <typename OnStudent>
+    static void scan_lines(std::string_view data, LoadStats& stats, RejectLog* reject_log,
+        const std::string& file, size_t first_line, OnStudent&& on_student) {
+        size_t pos = 0;
+        size_t line_number = first_line;
+        while (pos < data.size()) {
+            size_t eol = data.find('\n', pos);
+            if (eol == std::string_view::npos) {
+                eol = data.size();
+            }
+            ++stats.lines;
+            const std::string_view line = data.substr(pos, eol - pos);
+            RejectReason reason;
+            if (auto student = parse_student(line, reason)) {
+                on_student(*student);
+            }
+            else {
+                reject_line(stats, reason, reject_log, file, line_number, line);
+            }
+            ++line_number;
+            pos = eol + 1;
+        }
+    }
+
+    static void parse_lines(std::string_view data, StudentSet& students, LoadStats& stats,
+        RejectLog* reject_log = nullptr, const std::string& file = {}, size_t first_line = 1) {
+        scan_lines(data, stats, reject_log, file, first_line,
+            [&](const StudentStore::StudentView& student) { students.insert(student); });
+    }
+
+    void for_each_student_line(std::string_view data, const StudentLineHandler& on_student, LoadStats& stats,
+        RejectLog* reject_log, const std::string& file) {
+        scan_lines(data, stats, reject_log, file, 1, on_student);
+    }
+
+    static StudentSet load_sequential(const std::string& dir_path, RejectLog* reject_log, LoadStats& stats) {
+        // ���������� unordered_set ��� ��������������� ����������� ���������� ���������
+        StudentSet combined_students;
+
+        for (const auto& path : list_student_files(dir_path)) {
+            std::ifstream ifs(path);
+            if (!ifs.is_open()) {
+                std::cerr << "Error: Could not open file " << path.string() << std::endl;
+                continue;
+            }
+            ++stats.files;
+
+            const std::string file = path.string();
+            std::string line;
+            size_t line_number = 0;
+            while (std::getline(ifs, line)) {
+                ++stats.lines;
+                ++line_number;
+                RejectReason reason;
+                if (auto student = parse_student(line, reason)) {
+                    combined_students.insert(*student);
+                }
+                else {
+                    reject_line(stats, reason, reject_log, file, line_number, line);
+                }
+            }
+        }
 
-        if (std::regex_match(line, matches, student_regex) && matches.size() == 4) {
+        return combined_students;
+    }
+
+    static StudentSet load_parallel(const std::string& dir_path, size_t threads, RejectLog* reject_log, LoadStats& stats) {
+        // Участок файла, выровненный по границам строк
+        struct Segment {
+            size_t file_index;
+            size_t begin;
+            size_t end;
+            size_t first_line = 1;
+        };
+
+        std::vector<MappedFile> files;
+        std::vector<std::string> file_names;
+        size_t total_size = 0;
+        for (const auto& path : list_student_files(dir_path)) {
             try {
-                uint16_t id = static_cast<uint16_t>(std::stoul(matches[1].str()));
-                std::string fio = matches[2].str();
-                std::string date_str = matches[3].str();
+                files.emplace_back(path);
+                file_names.push_back(path.string());
+                total_size += files.back().size();
+            }
+            catch (const std::exception& e) {
+                std::cerr << "Error: " << e.what() << std::endl;
+            }
+        }
+        stats.files = files.size();
+        if (total_size == 0) {
+            return {};
+        }
 
-                // ������� ��������� � �������� ������� �� ���
-                size_t first = fio.find_first_not_of(' ');
-                size_t last = fio.find_last_not_of(' ');
-                if (first == std::string::npos) {
-                    fio = "";
+        // Крупные файлы режутся на части примерно равного размера
+        const size_t target_size = std::max<size_t>(total_size / threads, 64 * 1024);
+        std::vector<Segment> segments;
+        for (size_t i = 0; i < files.size(); ++i) {
+            std::string_view data = files[i].view();
+            size_t begin = 0;
+            size_t first_line = 1;
+            while (begin < data.size()) {
+                size_t end = begin + target_size;
+                if (end >= data.size()) {
+                    end = data.size();
                 }
                 else {
-                    fio = fio.substr(first, (last - first + 1));
+                    size_t eol = data.find('\n', end - 1);
+                    end = (eol == std::string_view::npos) ? data.size() : eol + 1;
+                }
+                segments.push_back({ i, begin, end, first_line });
+                // Номера строк нужны только журналу отбраковки - без него лишний проход не делается
+                if (reject_log) {
+                    first_line += static_cast<size_t>(std::count(data.begin() + begin, data.begin() + end, '\n'));
                 }
+                begin = end;
+            }
+        }
 
-                // дата рождения
-                std::chrono::year_month_day birth_date{};
-                std::tm tm = {};
-                std::istringstream date_ss(date_str);
+        // Каждый поток получает непрерывную последовательность участков,
+        // поэтому объединение частичных наборов по порядку потоков
+        // сохраняет правило "первая запись побеждает" последовательного режима
+        std::vector<size_t> first_segment(threads + 1, segments.size());
+        size_t offset = 0;
+        for (size_t s = 0, worker = 0; s < segments.size(); ++s) {
+            size_t owner = std::min(threads - 1, offset * threads / total_size);
+            while (worker <= owner) {
+                first_segment[worker++] = s;
+            }
+            offset += segments[s].end - segments[s].begin;
+        }
 
-                date_ss >> std::get_time(&tm, "%d.%m.%Y");
-                if (date_ss.fail()) {
-                    std::cerr << "Validation Error (Date): Invalid date format in line: " << line << std::endl;
-                    return std::nullopt;
+        std::vector<StudentSet> partial_sets(threads);
+        std::vector<LoadStats> partial_stats(threads);
+        std::vector<std::thread> workers;
+        workers.reserve(threads);
+        for (size_t w = 0; w < threads; ++w) {
+            workers.emplace_back([&, w] {
+                for (size_t s = first_segment[w]; s < first_segment[w + 1]; ++s) {
+                    const Segment& segment = segments[s];
+                    std::string_view data = files[segment.file_index].view();
+                    parse_lines(data.substr(segment.begin, segment.end - segment.begin), partial_sets[w], partial_stats[w],
+                        reject_log, file_names[segment.file_index], segment.first_line);
                 }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        for (const auto& partial : partial_stats) {
+            stats.add_lines(partial);
+        }
 
-                birth_date = std::chrono::year{tm.tm_year + 1900} /
-                            std::chrono::month{static_cast<unsigned>(tm.tm_mon + 1)} /
-                            std::chrono::day{static_cast<unsigned>(tm.tm_mday)};
+        StudentSet combined_students = std::move(partial_sets.front());
+        for (size_t w = 1; w < threads; ++w) {
+            // merge() оставляет уже существующие записи
+            combined_students.merge(partial_sets[w]);
+            partial_sets[w] = {};
+        }
+        return combined_students;
+    }
 
-                if (!birth_date.ok()) {
-                    std::cerr << "Validation Error (Date): Invalid date value in line: " << line << std::endl;
-                    return std::nullopt;
+    // Загрузка с кэшем. Записи файлов объединяются в порядке list_student_files по правилу
+    // "первая запись побеждает" - так же, как при загрузке без кэша, поэтому результат
+    // не зависит от того, какие файлы взяты из кэша. Изменившиеся файлы разбираются
+    // параллельно (по файлу на поток), после чего кэш перезаписывается
+    static StudentSet load_cached(const std::string& dir_path, const fs::path& cache_path, size_t threads,
+        RejectLog* reject_log, LoadStats& stats) {
+        // Кэш относится к каталогу: имена файлов в нём - ключи только внутри этого каталога
+        const std::string directory = fs::weakly_canonical(dir_path).string();
+        std::optional<MappedFile> cache_file;
+        std::unordered_map<std::string, CacheEntry> cached;
+        std::error_code ec;
+        if (fs::exists(cache_path, ec)) {
+            try {
+                cache_file.emplace(cache_path);
+                for (auto& entry : read_student_cache(cache_file->view(), directory)) {
+                    std::string name = entry.name;
+                    cached.emplace(std::move(name), std::move(entry));
                 }
+            }
+            catch (const std::exception& e) {
+                std::cerr << "Warning: Ignoring student cache " << cache_path.string() << ": " << e.what() << std::endl;
+                cached.clear();
+            }
+        }
+
+        struct FileState {
+            fs::path path;
+            CacheEntry entry;
+            bool from_cache = false;
+            bool cacheable = true;
+            StudentSet students;    // записи заново разобранного файла
+            std::string payload;    // они же в формате кэша
+        };
+
+        // Размер и время изменения снимаются до разбора: если файл меняется во время
+        // загрузки, при следующем запуске его время изменения уже не совпадёт с кэшем
+        std::vector<FileState> files;
+        std::vector<size_t> changed;
+        for (auto& path : list_student_files(dir_path)) {
+            FileState& file = files.emplace_back();
+            file.entry.name = path.filename().string();
+            file.entry.size = fs::file_size(path);
+            file.entry.mtime = static_cast<int64_t>(fs::last_write_time(path).time_since_epoch().count());
+            file.path = std::move(path);
+
+            auto it = cached.find(file.entry.name);
+            if (it != cached.end() && it->second.size == file.entry.size && it->second.mtime == file.entry.mtime) {
+                file.entry.stats = it->second.stats;
+                file.entry.payload = it->second.payload;
+                file.from_cache = true;
+            }
+            else {
+                changed.push_back(files.size() - 1);
+            }
+        }
 
-                if (fio.empty()) {
-                    std::cerr << "Validation Error (FIO): FIO is empty or contains only spaces in line: " << line << std::endl;
-                    return std::nullopt;
+        std::atomic<size_t> next_changed{ 0 };
+        auto parse_changed = [&] {
+            for (size_t c = next_changed++; c < changed.size(); c = next_changed++) {
+                FileState& file = files[changed[c]];
+                try {
+                    MappedFile mapped(file.path);
+                    parse_lines(mapped.view(), file.students, file.entry.stats, reject_log, file.path.string());
+                }
+                catch (const std::exception& e) {
+                    std::cerr << "Error: " << e.what() << std::endl;
+                    file.cacheable = false;
+                    continue;
+                }
+                try {
+                    file.payload = wire::encode_students(file.students.to_students(), wire::Format::Binary);
+                    file.entry.payload = file.payload;
+                }
+                catch (const std::exception&) {
+                    // Запись не помещается в формат кэша - файл будет разбираться при каждой загрузке
+                    file.cacheable = false;
                 }
+            }
+        };
+        auto run_parse_changed = [&] {
+            next_changed = 0;
+            const size_t workers_count = std::min(threads, changed.size());
+            if (workers_count <= 1) {
+                parse_changed();
+                return;
+            }
+            std::vector<std::thread> workers;
+            workers.reserve(workers_count);
+            for (size_t w = 0; w < workers_count; ++w) {
+                workers.emplace_back(parse_changed);
+            }
+            for (auto& worker : workers) {
+                worker.join();
+            }
+        };
+        run_parse_changed();
 
-                return domain::Student{ id, fio, birth_date };
+        // Объединение по порядку файлов; false - запись кэша повреждена и набор неполон
+        auto merge_files = [&](StudentSet& combined) {
+            for (auto& file : files) {
+                if (!file.from_cache) {
+                    combined.merge(file.students);
+                    continue;
+                }
+                try {
+                    wire::visit_binary_students(file.entry.payload,
+                        [&](uint16_t id, std::string_view fio, std::chrono::year_month_day birth_date) {
+                            combined.insert(id, fio, birth_date);
+                        });
+                }
+                catch (const std::exception& e) {
+                    std::cerr << "Warning: Ignoring student cache " << cache_path.string() << ": " << e.what() << std::endl;
+                    return false;
+                }
+            }
+            return true;
+        };
 
+        StudentSet combined_students;
+        if (!merge_files(combined_students)) {
+            // Часть записей уже добавлена - набор собирается заново. Разбираются только файлы,
+            // взятые из кэша: изменившиеся уже разобраны и второй раз в журнал отбраковки не попадают
+            changed.clear();
+            for (size_t i = 0; i < files.size(); ++i) {
+                if (files[i].from_cache) {
+                    files[i].from_cache = false;
+                    files[i].entry.stats = {};
+                    files[i].entry.payload = {};
+                    changed.push_back(i);
+                }
+            }
+            cached.clear();
+            cache_file.reset();
+            run_parse_changed();
+
+            combined_students = {};
+            merge_files(combined_students);
+        }
+        for (auto& file : files) {
+            file.students = {};
+        }
+
+        for (const auto& file : files) {
+            stats.add_lines(file.entry.stats);
+            stats.cached_files += file.from_cache ? 1 : 0;
+        }
+        stats.files = files.size();
+
+        // Кэш перезаписывается, если изменился хотя бы один файл или их набор
+        if (!changed.empty() || cached.size() != files.size()) {
+            std::vector<CacheEntry> entries;
+            entries.reserve(files.size());
+            for (const auto& file : files) {
+                if (file.cacheable) {
+                    entries.push_back(file.entry);
+                }
+            }
+            try {
+                const fs::path tmp_path = write_student_cache(cache_path, directory, entries);
+                cache_file.reset();
+                fs::rename(tmp_path, cache_path);
             }
             catch (const std::exception& e) {
-                std::cerr << "Parsing Error (Exception): " << e.what() << " in line: " << line << std::endl;
-                return std::nullopt;
+                // Каталог может быть доступен только для чтения - загрузка от этого не страдает
+                std::cerr << "Warning: Could not update student cache " << cache_path.string() << ": " << e.what() << std::endl;
             }
         }
-
-        std::cerr << "Parsing Error (Format): Invalid line format: " << line << std::endl;
-        return std::nullopt;
+        return combined_students;
     }
 
     // ������� ��� �������� � ����������� ������ �� ���� ������ � ����������
-    std::unordered_set<domain::Student, domain::Student::hash> load_all_students(const std::string& dir_path) {
-        // ���������� unordered_set ��� ��������������� ����������� ���������� ���������
-        std::unordered_set<domain::Student, domain::Student::hash> combined_students;
+    StudentSet load_all_students(const std::string& dir_path, const LoadOptions& options, LoadStats* stats) {
+        LoadStats local_stats;
+        LoadStats& counters = stats ? *stats : local_stats;
+        counters = LoadStats{};
+
+        size_t threads = options.threads;
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
 
         // �������� �� ���� ������ � ����������
         try {
-            for (const auto& entry : fs::directory_iterator(dir_path)) {
-                if (entry.is_regular_file() && entry.path().extension() == ".txt") {
-                    std::ifstream ifs(entry.path());
-                    if (!ifs.is_open()) {
-                        std::cerr << "Error: Could not open file " << entry.path().string() << std::endl;
-                        continue;
-                    }
-
-                    std::string line;
-                    while (std::getline(ifs, line)) {
-                        if (auto student = read_student_from_line(line)) {
-                            combined_students.insert(*student);
-                        }
-                    }
-                }
+            if (options.use_cache) {
+                const fs::path cache_path = options.cache_path.empty()
+                    ? default_cache_path(dir_path)
+                    : fs::path(options.cache_path);
+                return load_cached(dir_path, cache_path, threads, options.reject_log, counters);
             }
+            if (threads == 1) {
+                return load_sequential(dir_path, options.reject_log, counters);
+            }
+            return load_parallel(dir_path, threads, options.reject_log, counters);
         }
         catch (const fs::filesystem_error& e) {
             std::cerr << "Filesystem Error: " << e.what() << std::endl;
         }
 
-        return combined_students;
+        return {};
     }
 }
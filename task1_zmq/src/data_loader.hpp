@@ -1,12 +1,90 @@
 #pragma once
+#include <array>
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <map>
 #include <optional>
-#include <unordered_set>
 #include <string>
+#include <string_view>
+#include <vector>
 
+#include "reject_log.hpp"
 #include "student.hpp"
+#include "student_store.hpp"
 
 namespace data_loader
 {
+    using StudentSet = StudentStore;
+
+    struct LoadOptions {
+        // 1 - последовательное чтение через ifstream,
+        // >1 - параллельный разбор отображённых в память файлов,
+        // 0 - по числу аппаратных потоков
+        std::size_t threads = 1;
+        // Бинарный кэш разобранных файлов: файлы с прежними размером и временем
+        // изменения берутся из кэша, остальные разбираются заново, кэш обновляется.
+        // Пустой cache_path - default_cache_path(dir_path) во временном каталоге
+        bool use_cache = false;
+        std::string cache_path;
+        // Журнал отбракованных строк с файлом, номером строки и причиной;
+        // nullptr - строки только подсчитываются. Строки файлов из кэша не журналируются повторно
+        RejectLog* reject_log = nullptr;
+    };
+
+    // Счётчики строк последней загрузки
+    struct LoadStats {
+        std::size_t lines = 0;
+        std::size_t rejected = 0;   // строки, не прошедшие разбор или проверку
+        std::array<std::size_t, kRejectReasonCount> rejected_by_reason{};
+        std::size_t files = 0;
+        std::size_t cached_files = 0;   // файлы, взятые из кэша без разбора
+
+        void add_lines(const LoadStats& other) {
+            lines += other.lines;
+            rejected += other.rejected;
+            for (std::size_t i = 0; i < kRejectReasonCount; ++i) {
+                rejected_by_reason[i] += other.rejected_by_reason[i];
+            }
+        }
+    };
+
+    // Изменение набора студентов между двумя загрузками каталога
+    struct StudentDelta {
+        std::vector<domain::Student> added;     // новые записи и записи с изменившимся ID
+        std::vector<domain::Student> removed;
+
+        bool empty() const { return added.empty() && removed.empty(); }
+    };
+
+    StudentDelta diff_students(const StudentSet& before, const StudentSet& after);
+    void apply_delta(StudentSet& students, const StudentDelta& delta);
+
+    // Итог последовательности StudentDelta для списка, отсортированного по Student::order: по ключу
+    // (ФИО, дата рождения) - запись с последним ID или std::nullopt, если запись удалена
+    using ListingChanges = std::map<domain::Student, std::optional<domain::Student>, domain::Student::order>;
+
+    // Добавляет delta к накопленным изменениям по правилам apply_delta: сначала удаления, затем записи
+    void accumulate_delta(ListingChanges& changes, const StudentDelta& delta);
+    // Отсортированный список sorted с изменениями changes - один проход слияния без сортировки
+    std::vector<domain::Student> apply_changes(const std::vector<domain::Student>& sorted, const ListingChanges& changes);
+    // Слияние отсортированных списков без повторов ключа. Из записей с одинаковым ключом остаётся
+    // запись более раннего списка, как при объединении файлов в load_all_students
+    std::vector<domain::Student> merge_listings(const std::vector<const std::vector<domain::Student>*>& listings);
+
+    // Разбор строки "ID ФИО ДД.ММ.ГГГГ"; некорректные строки отбраковываются с сообщением в std::cerr.
+    // Загрузка каталога сообщения не выводит - см. LoadOptions::reject_log
+    std::optional<domain::Student> read_student_from_line(std::string_view line);
+
+    // Файлы *.txt каталога в порядке обхода; при совпадении ключей побеждает запись более раннего файла
+    std::vector<std::filesystem::path> list_student_files(const std::string& dir_path);
+
+    // Построчный разбор содержимого файла без объединения дубликатов: on_student получает
+    // каждую корректную строку (ФИО указывает внутрь data), отбракованные учитываются в stats
+    using StudentLineHandler = std::function<void(const StudentStore::StudentView& student)>;
+    void for_each_student_line(std::string_view data, const StudentLineHandler& on_student, LoadStats& stats,
+        RejectLog* reject_log = nullptr, const std::string& file = {});
+
     // Функция для загрузки и объединения данных из всех файлов в директории
-    std::unordered_set<domain::Student, domain::Student::hash> load_all_students(const std::string& dir_path);
+    StudentSet load_all_students(const std::string& dir_path, const LoadOptions& options = {}, LoadStats* stats = nullptr);
 }
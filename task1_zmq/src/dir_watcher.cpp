@@ -0,0 +1,116 @@
+#include "dir_watcher.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+
+#ifdef __linux__
+#include <cerrno>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace data_loader
+{
+    namespace fs = std::filesystem;
+
+    bool DirectoryWatcher::wait_for_change(std::chrono::milliseconds timeout, std::chrono::milliseconds quiet_period) {
+        // Посторонние события не прерывают ожидание значимого до истечения timeout
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        bool relevant = false;
+        while (!relevant) {
+            const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+            if (left.count() <= 0) {
+                return false;
+            }
+            const PollResult result = poll_once(left);
+            if (!result.seen) {
+                return false;
+            }
+            relevant = result.relevant;
+        }
+        // Пауза - quiet_period без каких-либо событий, в том числе посторонних. Непрерывный поток событий
+        // не держит ожидание дольше timeout (но не меньше quiet_period) от первого значимого события
+        const auto settle_deadline = std::chrono::steady_clock::now() + std::max(timeout, quiet_period);
+        for (;;) {
+            const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(settle_deadline - std::chrono::steady_clock::now());
+            if (left.count() <= 0 || !poll_once(std::min(quiet_period, left)).seen) {
+                return true;
+            }
+        }
+    }
+
+#ifdef __linux__
+    DirectoryWatcher::DirectoryWatcher(const std::string& dir_path)
+        : dir_(dir_path) {
+        inotify_fd_ = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (inotify_fd_ < 0) {
+            throw std::runtime_error("inotify_init1 failed");
+        }
+        const uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE;
+        if (::inotify_add_watch(inotify_fd_, dir_.c_str(), mask) < 0) {
+            ::close(inotify_fd_);
+            throw std::runtime_error("Could not watch directory " + dir_path);
+        }
+    }
+
+    DirectoryWatcher::~DirectoryWatcher() {
+        if (inotify_fd_ >= 0) {
+            ::close(inotify_fd_);
+        }
+    }
+
+    DirectoryWatcher::PollResult DirectoryWatcher::poll_once(std::chrono::milliseconds timeout) {
+        pollfd pfd{ inotify_fd_, POLLIN, 0 };
+        if (::poll(&pfd, 1, static_cast<int>(timeout.count())) <= 0) {
+            return {};
+        }
+
+        PollResult result;
+        alignas(inotify_event) char buffer[4096];
+        for (;;) {
+            const ssize_t len = ::read(inotify_fd_, buffer, sizeof(buffer));
+            if (len <= 0) {
+                break;
+            }
+            result.seen = true;
+            for (ssize_t offset = 0; offset < len; ) {
+                const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+                // Интересуют только файлы с данными студентов
+                if (event->len > 0 && fs::path(event->name).extension() == ".txt") {
+                    result.relevant = true;
+                }
+                offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+            }
+        }
+        return result;
+    }
+#else
+    DirectoryWatcher::DirectoryWatcher(const std::string& dir_path)
+        : dir_(dir_path), stamps_(scan()) {
+    }
+
+    DirectoryWatcher::~DirectoryWatcher() = default;
+
+    std::map<fs::path, DirectoryWatcher::FileStamp> DirectoryWatcher::scan() const {
+        std::map<fs::path, FileStamp> stamps;
+        std::error_code ec;
+        for (const auto& entry : fs::directory_iterator(dir_, ec)) {
+            if (entry.is_regular_file(ec) && entry.path().extension() == ".txt") {
+                stamps[entry.path()] = { entry.file_size(ec), entry.last_write_time(ec) };
+            }
+        }
+        return stamps;
+    }
+
+    DirectoryWatcher::PollResult DirectoryWatcher::poll_once(std::chrono::milliseconds timeout) {
+        std::this_thread::sleep_for(timeout);
+        auto stamps = scan();
+        if (stamps == stamps_) {
+            return {};
+        }
+        stamps_ = std::move(stamps);
+        return { true, true };
+    }
+#endif
+}
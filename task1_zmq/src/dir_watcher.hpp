@@ -0,0 +1,47 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+
+namespace data_loader
+{
+    // Отслеживание изменений файлов *.txt в каталоге с данными.
+    // В Linux используется inotify, на остальных платформах - опрос размера и времени изменения.
+    class DirectoryWatcher
+    {
+    public:
+        explicit DirectoryWatcher(const std::string& dir_path);
+        ~DirectoryWatcher();
+
+        DirectoryWatcher(const DirectoryWatcher&) = delete;
+        DirectoryWatcher& operator=(const DirectoryWatcher&) = delete;
+
+        // Ждёт изменения не дольше timeout. После первого значимого события дожидается
+        // паузы в quiet_period без каких-либо событий, чтобы серия записей давала одну перезагрузку.
+        // Пауза ждётся не дольше max(timeout, quiet_period) от этого события, даже если запись не прекращается
+        bool wait_for_change(std::chrono::milliseconds timeout,
+            std::chrono::milliseconds quiet_period = std::chrono::milliseconds(200));
+
+    private:
+        struct PollResult {
+            bool seen = false;          // пришли события (изменились отметки файлов)
+            bool relevant = false;      // среди них есть изменение файлов *.txt
+        };
+        PollResult poll_once(std::chrono::milliseconds timeout);
+
+        std::filesystem::path dir_;
+#ifdef __linux__
+        int inotify_fd_ = -1;
+#else
+        struct FileStamp {
+            std::uintmax_t size = 0;
+            std::filesystem::file_time_type mtime{};
+            bool operator==(const FileStamp&) const = default;
+        };
+        std::map<std::filesystem::path, FileStamp> scan() const;
+        std::map<std::filesystem::path, FileStamp> stamps_;
+#endif
+    };
+}
@@ -0,0 +1,356 @@
+#include "external_sort.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+
+#include "kway_merge.hpp"
+#include "mapped_file.hpp"
+
+namespace data_loader
+{
+    namespace fs = std::filesystem;
+
+    namespace {
+        // Столько прогонов сливается за один проход: открытые файлы и буферы чтения
+        constexpr size_t kMaxFanIn = 64;
+        constexpr size_t kMinBudget = size_t{ 1 } << 20;
+        constexpr size_t kMinReadBuffer = 64 * 1024;
+        constexpr size_t kMaxReadBuffer = size_t{ 4 } << 20;
+        constexpr size_t kWriteBuffer = size_t{ 1 } << 20;
+        constexpr size_t kRecordFixedSize = 2 + 4 + 2;
+
+        using FilePtr = std::unique_ptr<std::FILE, int (*)(std::FILE*)>;
+
+        bool same_key(const domain::Student& a, const domain::Student& b) {
+            return a.birth_date == b.birth_date && a.fio == b.fio;
+        }
+
+        // Память, которую запись занимает в буфере разбора, вместе с индексом сортировки
+        size_t footprint(const domain::Student& student) {
+            constexpr size_t kInlineCapacity = 15;  // короткие строки хранятся внутри std::string
+            return sizeof(uint32_t) + (student.fio.size() > kInlineCapacity ? student.fio.size() + 1 : 0);
+        }
+
+        fs::path make_spill_path(const fs::path& dir) {
+            static const uint64_t prefix = std::random_device{}();
+            static std::atomic<uint64_t> counter{ 0 };
+            return dir / ("students_" + std::to_string(prefix) + "_" + std::to_string(counter++) + ".run");
+        }
+
+        class RunWriter
+        {
+        public:
+            explicit RunWriter(fs::path path)
+                : path_(std::move(path)), out_(std::fopen(path_.string().c_str(), "wb"), &std::fclose) {
+                if (!out_) {
+                    throw std::runtime_error("Could not create spill file " + path_.string());
+                }
+                buffer_.reserve(kWriteBuffer + 4096);
+            }
+
+            // Незавершённый прогон удаляется
+            ~RunWriter() {
+                if (out_) {
+                    out_.reset();
+                    std::error_code ec;
+                    fs::remove(path_, ec);
+                }
+            }
+
+            void write(const domain::Student& student) {
+                if (student.fio.size() > UINT16_MAX) {
+                    throw std::runtime_error("FIO is too long for a spill record");
+                }
+                const auto days = static_cast<uint32_t>(domain::to_days(student.birth_date));
+                const auto length = static_cast<uint16_t>(student.fio.size());
+                const char fixed[kRecordFixedSize] = {
+                    static_cast<char>(student.id & 0xFF), static_cast<char>(student.id >> 8),
+                    static_cast<char>(days & 0xFF), static_cast<char>((days >> 8) & 0xFF),
+                    static_cast<char>((days >> 16) & 0xFF), static_cast<char>(days >> 24),
+                    static_cast<char>(length & 0xFF), static_cast<char>(length >> 8),
+                };
+                buffer_.append(fixed, kRecordFixedSize);
+                buffer_ += student.fio;
+                ++count_;
+                if (buffer_.size() >= kWriteBuffer) {
+                    flush();
+                }
+            }
+
+            SortedRunFile finish() {
+                flush();
+                if (std::fclose(out_.release()) != 0) {
+                    throw std::runtime_error("Could not write spill file " + path_.string());
+                }
+                return SortedRunFile(path_, count_);
+            }
+
+        private:
+            void flush() {
+                if (!buffer_.empty() && std::fwrite(buffer_.data(), 1, buffer_.size(), out_.get()) != buffer_.size()) {
+                    throw std::runtime_error("Could not write spill file " + path_.string());
+                }
+                buffer_.clear();
+            }
+
+            fs::path path_;
+            FilePtr out_;
+            std::string buffer_;
+            size_t count_ = 0;
+        };
+
+        // Источник для util::merge_sorted_streams
+        class RunReader
+        {
+        public:
+            RunReader(const fs::path& path, size_t buffer_size)
+                : path_(path), in_(std::fopen(path.string().c_str(), "rb"), &std::fclose), buffer_(buffer_size, '\0') {
+                if (!in_) {
+                    throw std::runtime_error("Could not open spill file " + path.string());
+                }
+            }
+
+            bool next(domain::Student& student) {
+                if (!fill(kRecordFixedSize)) {
+                    return false;
+                }
+                const auto* p = reinterpret_cast<const unsigned char*>(buffer_.data() + pos_);
+                student.id = static_cast<uint16_t>(p[0] | (p[1] << 8));
+                const auto days = static_cast<int32_t>(static_cast<uint32_t>(p[2]) | (static_cast<uint32_t>(p[3]) << 8) |
+                    (static_cast<uint32_t>(p[4]) << 16) | (static_cast<uint32_t>(p[5]) << 24));
+                const size_t length = static_cast<size_t>(p[6] | (p[7] << 8));
+                pos_ += kRecordFixedSize;
+                if (!fill(length) && length > 0) {
+                    throw std::runtime_error("Spill file is truncated: " + path_.string());
+                }
+                student.fio.assign(buffer_.data() + pos_, length);
+                student.birth_date = domain::from_days(days);
+                pos_ += length;
+                return true;
+            }
+
+        private:
+            // false - конец файла ровно на границе записи; обрыв внутри записи - исключение
+            bool fill(size_t n) {
+                if (end_ - pos_ >= n) {
+                    return true;
+                }
+                if (n > buffer_.size()) {
+                    buffer_.resize(n);
+                }
+                std::copy(buffer_.begin() + pos_, buffer_.begin() + end_, buffer_.begin());
+                end_ -= pos_;
+                pos_ = 0;
+                end_ += std::fread(buffer_.data() + end_, 1, buffer_.size() - end_, in_.get());
+                if (end_ >= n) {
+                    return true;
+                }
+                if (end_ == 0) {
+                    return false;
+                }
+                throw std::runtime_error("Spill file is truncated: " + path_.string());
+            }
+
+            fs::path path_;
+            FilePtr in_;
+            std::string buffer_;
+            size_t pos_ = 0;
+            size_t end_ = 0;
+        };
+
+        // Слияние соседних прогонов [begin, end) в один; прогоны идут в порядке ввода
+        SortedRunFile merge_group(std::vector<SortedRunFile>& runs, size_t begin, size_t end,
+            const fs::path& spill_dir, size_t budget) {
+            const size_t read_buffer = std::clamp(budget / (end - begin + 1), kMinReadBuffer, kMaxReadBuffer);
+            std::vector<RunReader> readers;
+            readers.reserve(end - begin);
+            for (size_t i = begin; i < end; ++i) {
+                readers.emplace_back(runs[i].path(), read_buffer);
+            }
+
+            RunWriter writer(make_spill_path(spill_dir));
+            domain::Student last;
+            bool have_last = false;
+            util::merge_sorted_streams<domain::Student>(readers, domain::Student::order{},
+                [&](domain::Student&& student) {
+                    // Из равных ключей первым приходит прогон с меньшим номером - более ранний ввод
+                    if (have_last && same_key(last, student)) {
+                        return;
+                    }
+                    writer.write(student);
+                    last = std::move(student);
+                    have_last = true;
+                });
+            return writer.finish();
+        }
+    }
+
+    SortedRunFile::SortedRunFile(std::filesystem::path path, std::size_t count)
+        : path_(std::move(path)), count_(count) {
+    }
+
+    SortedRunFile::~SortedRunFile() {
+        remove();
+    }
+
+    SortedRunFile::SortedRunFile(SortedRunFile&& other) noexcept
+        : path_(std::move(other.path_)), count_(std::exchange(other.count_, 0)) {
+        other.path_.clear();
+    }
+
+    SortedRunFile& SortedRunFile::operator=(SortedRunFile&& other) noexcept {
+        if (this != &other) {
+            remove();
+            path_ = std::move(other.path_);
+            count_ = std::exchange(other.count_, 0);
+            other.path_.clear();
+        }
+        return *this;
+    }
+
+    void SortedRunFile::remove() noexcept {
+        if (!path_.empty()) {
+            std::error_code ec;
+            fs::remove(path_, ec);
+            path_.clear();
+        }
+        count_ = 0;
+    }
+
+    void SortedRunFile::for_each(const std::function<void(domain::Student&&)>& visitor) const {
+        if (path_.empty()) {
+            return;
+        }
+        RunReader reader(path_, kMaxReadBuffer);
+        domain::Student student;
+        while (reader.next(student)) {
+            visitor(std::move(student));
+        }
+    }
+
+    SortedRunFile load_all_students_external(const std::string& dir_path, const ExternalOptions& options, LoadStats* stats) {
+        LoadStats local_stats;
+        LoadStats& counters = stats ? *stats : local_stats;
+        counters = LoadStats{};
+
+        const fs::path spill_dir = options.spill_dir.empty() ? fs::temp_directory_path() : fs::path(options.spill_dir);
+        fs::create_directories(spill_dir);
+        const size_t budget = std::max(options.memory_budget, kMinBudget);
+
+        // Буфер разбора: записи и их индексы; сортируются индексы, чтобы при равных ключах
+        // сохранить порядок ввода без дополнительной памяти std::stable_sort
+        std::vector<SortedRunFile> runs;
+        std::vector<domain::Student> buffer;
+        size_t buffered = 0;
+        auto spill = [&] {
+            if (buffer.empty()) {
+                return;
+            }
+            std::vector<uint32_t> order(buffer.size());
+            std::iota(order.begin(), order.end(), 0u);
+            std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+                const domain::Student::order less;
+                if (less(buffer[a], buffer[b])) return true;
+                if (less(buffer[b], buffer[a])) return false;
+                return a < b;
+            });
+
+            RunWriter writer(make_spill_path(spill_dir));
+            const domain::Student* previous = nullptr;
+            for (const uint32_t index : order) {
+                if (previous && same_key(*previous, buffer[index])) {
+                    continue;
+                }
+                writer.write(buffer[index]);
+                previous = &buffer[index];
+            }
+            runs.push_back(writer.finish());
+            // Ёмкость тоже освобождается: она входит в бюджет, и с прежней ёмкостью
+            // следующая же строка снова вызвала бы сброс
+            std::vector<domain::Student>().swap(buffer);
+            buffered = 0;
+        };
+
+        for (const auto& path : list_student_files(dir_path)) {
+            std::optional<MappedFile> file;
+            try {
+                file.emplace(path);
+            }
+            catch (const std::exception& e) {
+                std::cerr << "Error: " << e.what() << std::endl;
+                continue;
+            }
+            ++counters.files;
+            for_each_student_line(file->view(), [&](const StudentStore::StudentView& student) {
+                buffer.push_back(student.to_student());
+                buffered += footprint(buffer.back());
+                if (buffered + buffer.capacity() * sizeof(domain::Student) >= budget) {
+                    spill();
+                }
+            }, counters, options.reject_log, path.string());
+        }
+        spill();
+        std::vector<domain::Student>().swap(buffer);
+
+        if (runs.empty()) {
+            return RunWriter(make_spill_path(spill_dir)).finish();
+        }
+        // Соседние прогоны сливаются группами, порядок групп сохраняет порядок ввода
+        while (runs.size() > 1) {
+            std::vector<SortedRunFile> merged;
+            for (size_t begin = 0; begin < runs.size(); begin += kMaxFanIn) {
+                const size_t end = std::min(begin + kMaxFanIn, runs.size());
+                if (end - begin == 1) {
+                    merged.push_back(std::move(runs[begin]));
+                    continue;
+                }
+                merged.push_back(merge_group(runs, begin, end, spill_dir, budget));
+                for (size_t i = begin; i < end; ++i) {
+                    runs[i] = SortedRunFile{};
+                }
+            }
+            runs = std::move(merged);
+        }
+        return std::move(runs.front());
+    }
+
+    StudentDelta diff_students(const SortedRunFile& before, const SortedRunFile& after) {
+        StudentDelta delta;
+        if (before.path().empty() || after.path().empty()) {
+            before.for_each([&](domain::Student&& student) { delta.removed.push_back(std::move(student)); });
+            after.for_each([&](domain::Student&& student) { delta.added.push_back(std::move(student)); });
+            return delta;
+        }
+
+        RunReader old_reader(before.path(), kMaxReadBuffer);
+        RunReader new_reader(after.path(), kMaxReadBuffer);
+        domain::Student old_student, new_student;
+        bool have_old = old_reader.next(old_student);
+        bool have_new = new_reader.next(new_student);
+        const domain::Student::order less;
+        while (have_old || have_new) {
+            if (have_old && (!have_new || less(old_student, new_student))) {
+                delta.removed.push_back(std::move(old_student));
+                have_old = old_reader.next(old_student);
+            }
+            else if (have_new && (!have_old || less(new_student, old_student))) {
+                delta.added.push_back(std::move(new_student));
+                have_new = new_reader.next(new_student);
+            }
+            else {
+                // Тот же ключ: запись с изменившимся ID считается добавленной, как в diff_students для наборов
+                if (old_student.id != new_student.id) {
+                    delta.added.push_back(std::move(new_student));
+                }
+                have_old = old_reader.next(old_student);
+                have_new = new_reader.next(new_student);
+            }
+        }
+        return delta;
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <string>
+
+#include "data_loader.hpp"
+
+namespace data_loader
+{
+    struct ExternalOptions {
+        // Память под буфер разбора и буферы чтения при слиянии, байт
+        std::size_t memory_budget = std::size_t{ 256 } << 20;
+        // Каталог временных файлов; пусто - системный временный каталог
+        std::string spill_dir;
+        RejectLog* reject_log = nullptr;
+    };
+
+    // Набор студентов во временном файле: записи без дубликатов в порядке Student::order,
+    // каждая в формате записи wire::Format::Binary. Файл удаляется вместе с объектом
+    class SortedRunFile
+    {
+    public:
+        SortedRunFile() = default;
+        SortedRunFile(std::filesystem::path path, std::size_t count);
+        ~SortedRunFile();
+
+        SortedRunFile(SortedRunFile&& other) noexcept;
+        SortedRunFile& operator=(SortedRunFile&& other) noexcept;
+        SortedRunFile(const SortedRunFile&) = delete;
+        SortedRunFile& operator=(const SortedRunFile&) = delete;
+
+        std::size_t size() const { return count_; }
+        bool empty() const { return count_ == 0; }
+        const std::filesystem::path& path() const { return path_; }
+
+        // Последовательное чтение записей; бросает std::runtime_error при ошибке чтения
+        void for_each(const std::function<void(domain::Student&&)>& visitor) const;
+
+    private:
+        void remove() noexcept;
+
+        std::filesystem::path path_;
+        std::size_t count_ = 0;
+    };
+
+    // Загрузка каталога, не удерживающая весь набор в памяти. Строки файлов копятся в буфере
+    // не больше memory_budget; заполненный буфер сортируется, дубликаты в нём отбрасываются,
+    // и он сбрасывается на диск отсортированным прогоном. Прогоны сливаются потоковым
+    // k-путевым слиянием (в несколько проходов, если их много). Равные ключи упорядочены
+    // по порядку ввода, поэтому побеждает та же запись, что и в load_all_students.
+    // Бросает исключения при ошибках записи временных файлов
+    SortedRunFile load_all_students_external(const std::string& dir_path, const ExternalOptions& options,
+        LoadStats* stats = nullptr);
+
+    // Изменение между двумя отсортированными наборами за один последовательный проход
+    StudentDelta diff_students(const SortedRunFile& before, const SortedRunFile& after);
+}
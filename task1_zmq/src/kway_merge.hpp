@@ -0,0 +1,79 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace util
+{
+    // Слияние k отсортированных последовательностей через min-кучу за O(n log k).
+    // Элементы перемещаются в output по одному; опустевшие последовательности освобождаются сразу.
+    template <typename T, typename Compare, typename Output>
+    void merge_sorted_runs(std::vector<std::vector<T>> runs, Compare comp, Output&& output) {
+        std::vector<size_t> positions(runs.size(), 0);
+        std::vector<size_t> heap;
+        heap.reserve(runs.size());
+        for (size_t i = 0; i < runs.size(); ++i) {
+            if (!runs[i].empty()) {
+                heap.push_back(i);
+            }
+        }
+
+        // std::push_heap строит max-кучу, поэтому сравнение инвертировано
+        auto heap_less = [&](size_t a, size_t b) {
+            return comp(runs[b][positions[b]], runs[a][positions[a]]);
+        };
+        std::make_heap(heap.begin(), heap.end(), heap_less);
+
+        while (!heap.empty()) {
+            std::pop_heap(heap.begin(), heap.end(), heap_less);
+            const size_t run = heap.back();
+            output(std::move(runs[run][positions[run]]));
+
+            if (++positions[run] < runs[run].size()) {
+                std::push_heap(heap.begin(), heap.end(), heap_less);
+            }
+            else {
+                heap.pop_back();
+                std::vector<T>().swap(runs[run]);
+            }
+        }
+    }
+
+    // Потоковое слияние k отсортированных источников за O(n log k) без их загрузки в память.
+    // Source::next(T&) читает очередной элемент и возвращает false в конце источника.
+    // Равные элементы выдаются в порядке номеров источников - на этом основано правило
+    // "первая запись побеждает" при внешней сортировке
+    template <typename T, typename Source, typename Compare, typename Output>
+    void merge_sorted_streams(std::vector<Source>& sources, Compare comp, Output&& output) {
+        std::vector<T> heads(sources.size());
+        std::vector<size_t> heap;
+        heap.reserve(sources.size());
+        for (size_t i = 0; i < sources.size(); ++i) {
+            if (sources[i].next(heads[i])) {
+                heap.push_back(i);
+            }
+        }
+
+        auto heap_less = [&](size_t a, size_t b) {
+            if (comp(heads[b], heads[a])) {
+                return true;
+            }
+            return !comp(heads[a], heads[b]) && b < a;
+        };
+        std::make_heap(heap.begin(), heap.end(), heap_less);
+
+        while (!heap.empty()) {
+            std::pop_heap(heap.begin(), heap.end(), heap_less);
+            const size_t source = heap.back();
+            output(std::move(heads[source]));
+
+            if (sources[source].next(heads[source])) {
+                std::push_heap(heap.begin(), heap.end(), heap_less);
+            }
+            else {
+                heap.pop_back();
+            }
+        }
+    }
+}
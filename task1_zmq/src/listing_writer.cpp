@@ -0,0 +1,155 @@
+#include "listing_writer.hpp"
+#include <filesystem>
+#include <format>
+#include <iterator>
+#include <stdexcept>
+
+namespace render
+{
+    namespace fs = std::filesystem;
+
+    namespace {
+        // Буфер сбрасывается в поток, когда превышает этот размер
+        constexpr size_t kFlushThreshold = 1 << 20;
+
+        constexpr std::string_view kRule = "=======================================================\n";
+
+        // Ширина колонки ФИО в байтах, как у std::setw(30) в прежнем выводе
+        constexpr size_t kFioWidth = 30;
+
+        void append_padded(std::string& out, std::string_view text, size_t width) {
+            out.append(text);
+            if (text.size() < width) {
+                out.append(width - text.size(), ' ');
+            }
+        }
+
+        void append_csv_field(std::string& out, std::string_view text) {
+            if (text.find_first_of(",\"\n\r") == std::string_view::npos) {
+                out.append(text);
+                return;
+            }
+            out.push_back('"');
+            for (char c : text) {
+                if (c == '"') {
+                    out.push_back('"');
+                }
+                out.push_back(c);
+            }
+            out.push_back('"');
+        }
+    }
+
+    std::optional<OutputFormat> parse_output_format(std::string_view name) {
+        if (name == "text") return OutputFormat::Text;
+        if (name == "csv") return OutputFormat::Csv;
+        return std::nullopt;
+    }
+
+    ListingWriter::ListingWriter(std::string path, OutputFormat format)
+        : path_(std::move(path)), format_(format) {
+        buffer_.reserve(kFlushThreshold + 4096);
+        if (path_.empty()) {
+            return;
+        }
+
+        std::error_code ec;
+        const auto status = fs::status(path_, ec);
+        replace_file_ = !fs::exists(status) || fs::is_regular_file(status);
+        if (!replace_file_) {
+            // Канал держится открытым: читатель получает каждый новый список
+            stream_ = std::fopen(path_.c_str(), "wb");
+            if (stream_ == nullptr) {
+                throw std::runtime_error("Could not open output " + path_);
+            }
+        }
+    }
+
+    ListingWriter::~ListingWriter() {
+        if (stream_ != nullptr) {
+            std::fclose(stream_);
+        }
+    }
+
+    void ListingWriter::write(const std::vector<domain::Student>& students) {
+        if (!replace_file_) {
+            std::FILE* out = path_.empty() ? stdout : stream_;
+            format_ == OutputFormat::Csv ? format_csv(students, out) : format_text(students, out);
+            flush(out);
+            std::fflush(out);
+            return;
+        }
+
+        // Читатель файла никогда не видит частично записанный список
+        const std::string tmp_path = path_ + ".tmp";
+        std::FILE* out = std::fopen(tmp_path.c_str(), "wb");
+        if (out == nullptr) {
+            throw std::runtime_error("Could not open output " + tmp_path);
+        }
+        try {
+            format_ == OutputFormat::Csv ? format_csv(students, out) : format_text(students, out);
+            flush(out);
+        }
+        catch (...) {
+            std::fclose(out);
+            throw;
+        }
+        if (std::fclose(out) != 0) {
+            throw std::runtime_error("Could not write output " + tmp_path);
+        }
+        fs::rename(tmp_path, path_);
+    }
+
+    // Раскладка совпадает побайтно с прежним выводом через std::setw:
+    // номер дополняется до 3 символов, ФИО - до 30 байт
+    void ListingWriter::format_text(const std::vector<domain::Student>& students, std::FILE* out) {
+        auto it = std::back_inserter(buffer_);
+        buffer_.push_back('\n');
+        buffer_.append(kRule);
+        std::format_to(it, "       Sorted Student List (Total: {})\n", students.size());
+        buffer_.append(kRule);
+
+        for (size_t i = 0; i < students.size(); ++i) {
+            const auto& student = students[i];
+            std::format_to(it, "{:<3}. ", i + 1);
+            append_padded(buffer_, student.fio, kFioWidth);
+            std::format_to(it, " | {:02}.{:02}.{:04} (ID: {})\n",
+                static_cast<unsigned>(student.birth_date.day()),
+                static_cast<unsigned>(student.birth_date.month()),
+                static_cast<int>(student.birth_date.year()),
+                student.id);
+            flush_if_full(out);
+        }
+        buffer_.append(kRule);
+    }
+
+    void ListingWriter::format_csv(const std::vector<domain::Student>& students, std::FILE* out) {
+        auto it = std::back_inserter(buffer_);
+        buffer_.append("index,fio,birth_date,id\n");
+        for (size_t i = 0; i < students.size(); ++i) {
+            const auto& student = students[i];
+            std::format_to(it, "{},", i + 1);
+            append_csv_field(buffer_, student.fio);
+            std::format_to(it, ",{:04}-{:02}-{:02},{}\n",
+                static_cast<int>(student.birth_date.year()),
+                static_cast<unsigned>(student.birth_date.month()),
+                static_cast<unsigned>(student.birth_date.day()),
+                student.id);
+            flush_if_full(out);
+        }
+    }
+
+    void ListingWriter::flush_if_full(std::FILE* out) {
+        if (buffer_.size() >= kFlushThreshold) {
+            flush(out);
+        }
+    }
+
+    void ListingWriter::flush(std::FILE* out) {
+        if (!buffer_.empty() && std::fwrite(buffer_.data(), 1, buffer_.size(), out) != buffer_.size()) {
+            buffer_.clear();
+            throw std::runtime_error("Could not write output " + (path_.empty() ? std::string("stdout") : path_));
+        }
+        buffer_.clear();
+    }
+}
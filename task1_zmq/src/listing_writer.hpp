@@ -0,0 +1,47 @@
+#pragma once
+#include <cstdio>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "student.hpp"
+
+namespace render
+{
+    // Text - таблица в формате консольного вывода, Csv - "index,fio,birth_date,id"
+    enum class OutputFormat { Text, Csv };
+
+    std::optional<OutputFormat> parse_output_format(std::string_view name);
+
+    // Вывод отсортированного списка студентов.
+    // Строки форматируются в один переиспользуемый буфер и пишутся крупными блоками.
+    // Пустой путь - стандартный вывод; канал (FIFO) или устройство получает поток списков;
+    // обычный файл каждый раз целиком заменяется последним списком (через временный файл)
+    class ListingWriter
+    {
+    public:
+        explicit ListingWriter(std::string path = {}, OutputFormat format = OutputFormat::Text);
+        ~ListingWriter();
+
+        ListingWriter(const ListingWriter&) = delete;
+        ListingWriter& operator=(const ListingWriter&) = delete;
+
+        // Бросает std::runtime_error, если файл не удалось открыть или записать
+        void write(const std::vector<domain::Student>& students);
+
+        bool to_console() const { return path_.empty(); }
+
+    private:
+        void format_text(const std::vector<domain::Student>& students, std::FILE* out);
+        void format_csv(const std::vector<domain::Student>& students, std::FILE* out);
+        void flush(std::FILE* out);
+        void flush_if_full(std::FILE* out);
+
+        std::string path_;
+        OutputFormat format_;
+        bool replace_file_ = false;
+        std::FILE* stream_ = nullptr;
+        std::string buffer_;
+    };
+}
@@ -23,10 +23,69 @@ int main(int argc, char** argv) {
 	std::string mode;
 	std::string dir;
 	std::string url = "tcp://127.0.0.1:5555";
+	std::vector<std::string> snapshot_urls;
+	std::string upstream_url;
+	std::size_t loader_threads = 1;
+	bool use_cache = false;
+	std::string cache_path;
+	std::string reject_file;
+	std::size_t memory_budget = 0;
+	std::string spill_dir;
+	std::string format = "binary";
+	std::vector<std::string> topics;
+	std::size_t chunk_size = 10000;
+	std::size_t queue_capacity = 4096;
+	std::string output_path;
+	std::string output_format = "text";
+	bool once = false;
+	std::string metrics_file;
+	std::size_t metrics_interval = 5;
+	std::size_t publish_interval_ms = 5000;
+	int sndhwm = 1000;
 
-	app.add_option("-m,--mode", mode, "Mode: server or client")->required();
+	app.add_option("-m,--mode", mode, "Mode: server, client or proxy")->required();
 	app.add_option("-d,--dir", dir, "Directory with student files (server only)");
-	app.add_option("-u,--url", url, "Connection URL (default tcp://127.0.0.1:5555)");
+	app.add_option("-u,--url", url, "Connection URL; the proxy binds its XPUB socket here (default tcp://127.0.0.1:5555)");
+	app.add_option("-s,--snapshot-url", snapshot_urls,
+		"Snapshot request URL (default tcp://127.0.0.1:5556); a client behind a proxy takes a comma-separated list, "
+		"one per server, earlier servers win on duplicate FIO + birth date")
+		->delimiter(',');
+	app.add_option("--upstream-url", upstream_url,
+		"Proxy XSUB URL: the proxy binds it, servers publish to it instead of binding -u (proxy default tcp://127.0.0.1:5557)");
+	app.add_option("--loader-threads", loader_threads,
+		"Threads for parsing student files (server only, default 1, 0 = all cores)");
+	app.add_flag("--cache", use_cache,
+		"Reuse a binary cache of parsed student files across restarts; unchanged files are not parsed again (server only)");
+	app.add_option("--cache-file", cache_path,
+		"Cache file, implies --cache (server only, default students-<hash>.cache in the temp directory)");
+	app.add_option("--reject-file", reject_file,
+		"CSV file (file,line,reason,text) collecting rejected input lines (server only, default messages on stderr)");
+	app.add_option("--memory-budget", memory_budget,
+		"Load through sorted runs on disk within this many MiB, for data larger than RAM (server only, default 0 = in memory)");
+	app.add_option("--spill-dir", spill_dir, "Directory for the sorted runs of --memory-budget (server only, default temp dir)");
+	app.add_option("-t,--topics", topics,
+		"Comma-separated FIO initial letters to subscribe to (client only, default all)")
+		->delimiter(',');
+	app.add_option("--chunk-size", chunk_size, "Records per snapshot chunk (server only, default 10000)")
+		->check(CLI::PositiveNumber);
+	app.add_option("--queue-capacity", queue_capacity,
+		"Messages buffered between the receive and decode stages (client only, default 4096)")
+		->check(CLI::PositiveNumber);
+	app.add_option("-o,--output", output_path,
+		"File or pipe for the sorted student list (client only, default console)");
+	app.add_flag("--once", once, "Exit after printing the first sorted list (client only)");
+	app.add_option("--output-format", output_format, "Sorted list format: text or csv (client only, default text)")
+		->check(CLI::IsMember({ "text", "csv" }));
+	app.add_option("--metrics-file", metrics_file, "JSON file with counters and latency histograms, rewritten periodically");
+	app.add_option("--metrics-interval", metrics_interval, "Seconds between metrics file updates (default 5)")
+		->check(CLI::PositiveNumber);
+	app.add_option("--publish-interval", publish_interval_ms,
+		"Heartbeat period in milliseconds when nothing changes (server only, default 5000)")
+		->check(CLI::PositiveNumber);
+	app.add_option("--sndhwm", sndhwm, "PUB/XPUB socket send high-water mark, 0 = unlimited (server and proxy, default 1000)")
+		->check(CLI::NonNegativeNumber);
+	app.add_option("-f,--format", format, "Payload format: binary or json (server only, default binary)")
+		->check(CLI::IsMember({ "binary", "json" }));
 
 	try {
 		app.parse(argc, argv);
@@ -35,6 +94,10 @@ int main(int argc, char** argv) {
 		return app.exit(e);
 	}
 
+	if (snapshot_urls.empty()) {
+		snapshot_urls.push_back("tcp://127.0.0.1:5556");
+	}
+
 	std::unique_ptr<server::Server> server_ptr;
 
 	if (mode == "server") {
@@ -42,17 +105,63 @@ int main(int argc, char** argv) {
 			std::cerr << "Error: directory required in server mode! Use -d or --dir." << std::endl;
 			return 1;
 		}
-		std::cout << "Starting server (PUB) at " << url << " with data from " << dir << std::endl;
-		server_ptr = std::make_unique<server::Server>(server::Options{ server::TypeMode::Listener, url, dir });
+		if (snapshot_urls.size() != 1) {
+			std::cerr << "Error: server mode binds a single snapshot URL." << std::endl;
+			return 1;
+		}
+		std::cout << "Starting server (PUB) at " << (upstream_url.empty() ? url : upstream_url) << " with data from " << dir << std::endl;
+		server::Options options;
+		options.typeMode = server::TypeMode::Listener;
+		options.url = url;
+		options.dir = dir;
+		options.snapshot_urls = snapshot_urls;
+		options.upstream_url = upstream_url;
+		options.loader_threads = loader_threads;
+		options.use_cache = use_cache || !cache_path.empty();
+		options.cache_path = cache_path;
+		options.reject_file = reject_file;
+		options.memory_budget = memory_budget;
+		options.spill_dir = spill_dir;
+		options.format = *wire::parse_format(format);
+		options.chunk_size = chunk_size;
+		options.publish_interval_ms = publish_interval_ms;
+		options.sndhwm = sndhwm;
+		options.metrics_file = metrics_file;
+		options.metrics_interval = metrics_interval;
+		server_ptr = std::make_unique<server::Server>(options);
 		server_ptr->run(g_is_running); // Передаем флаг в метод run
 	}
 	else if (mode == "client") {
 		std::cout << "Starting client (SUB), listening at " << url << std::endl;
-		server_ptr = std::make_unique<server::Server>(server::Options{ server::TypeMode::Publisher, url });
+		server::Options options;
+		options.typeMode = server::TypeMode::Publisher;
+		options.url = url;
+		options.snapshot_urls = snapshot_urls;
+		options.topics = topics;
+		options.queue_capacity = queue_capacity;
+		options.output_path = output_path;
+		options.output_format = *render::parse_output_format(output_format);
+		options.exit_after_listing = once;
+		options.metrics_file = metrics_file;
+		options.metrics_interval = metrics_interval;
+		server_ptr = std::make_unique<server::Server>(options);
 		server_ptr->run(g_is_running); // Передаем флаг в метод run
 	}
+	else if (mode == "proxy") {
+		std::cout << "Starting proxy (XSUB/XPUB), clients connect to " << url << std::endl;
+		server::Options options;
+		options.typeMode = server::TypeMode::Proxy;
+		options.url = url;
+		options.snapshot_urls = snapshot_urls;
+		options.upstream_url = upstream_url.empty() ? "tcp://127.0.0.1:5557" : upstream_url;
+		options.sndhwm = sndhwm;
+		options.metrics_file = metrics_file;
+		options.metrics_interval = metrics_interval;
+		server_ptr = std::make_unique<server::Server>(options);
+		server_ptr->run(g_is_running);
+	}
 	else {
-		std::cerr << "Unknown mode: " << mode << ". Use 'server' or 'client'." << std::endl;
+		std::cerr << "Unknown mode: " << mode << ". Use 'server', 'client' or 'proxy'." << std::endl;
 		return 1;
 	}
 
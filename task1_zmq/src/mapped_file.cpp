@@ -0,0 +1,135 @@
+#include "mapped_file.hpp"
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace data_loader
+{
+#ifdef _WIN32
+    MappedFile::MappedFile(const std::filesystem::path& path) {
+        HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            throw std::runtime_error("Could not open file " + path.string());
+        }
+        file_handle_ = file;
+
+        LARGE_INTEGER file_size{};
+        if (!GetFileSizeEx(file, &file_size)) {
+            release();
+            throw std::runtime_error("Could not get size of file " + path.string());
+        }
+        size_ = static_cast<std::size_t>(file_size.QuadPart);
+        if (size_ == 0) {
+            return;
+        }
+
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr) {
+            release();
+            throw std::runtime_error("Could not map file " + path.string());
+        }
+        mapping_handle_ = mapping;
+
+        data_ = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        if (data_ == nullptr) {
+            release();
+            throw std::runtime_error("Could not map view of file " + path.string());
+        }
+    }
+
+    void MappedFile::release() noexcept {
+        if (data_ != nullptr) UnmapViewOfFile(data_);
+        if (mapping_handle_ != nullptr) CloseHandle(static_cast<HANDLE>(mapping_handle_));
+        if (file_handle_ != nullptr) CloseHandle(static_cast<HANDLE>(file_handle_));
+        data_ = nullptr;
+        size_ = 0;
+        mapping_handle_ = nullptr;
+        file_handle_ = nullptr;
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr)),
+          size_(std::exchange(other.size_, 0)),
+          file_handle_(std::exchange(other.file_handle_, nullptr)),
+          mapping_handle_(std::exchange(other.mapping_handle_, nullptr)) {
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            release();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+            file_handle_ = std::exchange(other.file_handle_, nullptr);
+            mapping_handle_ = std::exchange(other.mapping_handle_, nullptr);
+        }
+        return *this;
+    }
+#else
+    MappedFile::MappedFile(const std::filesystem::path& path) {
+        fd_ = ::open(path.c_str(), O_RDONLY);
+        if (fd_ < 0) {
+            throw std::runtime_error("Could not open file " + path.string());
+        }
+
+        struct stat st {};
+        if (::fstat(fd_, &st) != 0) {
+            release();
+            throw std::runtime_error("Could not get size of file " + path.string());
+        }
+        size_ = static_cast<std::size_t>(st.st_size);
+        if (size_ == 0) {
+            return;
+        }
+
+        void* addr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+        if (addr == MAP_FAILED) {
+            size_ = 0;
+            release();
+            throw std::runtime_error("Could not map file " + path.string());
+        }
+        data_ = static_cast<const char*>(addr);
+        // Файл читается последовательно от начала до конца
+        ::madvise(addr, size_, MADV_SEQUENTIAL);
+    }
+
+    void MappedFile::release() noexcept {
+        if (data_ != nullptr) ::munmap(const_cast<char*>(data_), size_);
+        if (fd_ >= 0) ::close(fd_);
+        data_ = nullptr;
+        size_ = 0;
+        fd_ = -1;
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr)),
+          size_(std::exchange(other.size_, 0)),
+          fd_(std::exchange(other.fd_, -1)) {
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            release();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+            fd_ = std::exchange(other.fd_, -1);
+        }
+        return *this;
+    }
+#endif
+
+    MappedFile::~MappedFile() {
+        release();
+    }
+}
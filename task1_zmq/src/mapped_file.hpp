@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+
+namespace data_loader
+{
+    // Отображение файла в память только для чтения (mmap / MapViewOfFile).
+    // Пустой файл отображается как пустой диапазон без системного вызова.
+    class MappedFile
+    {
+    public:
+        explicit MappedFile(const std::filesystem::path& path);
+        ~MappedFile();
+
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        const char* data() const { return data_; }
+        std::size_t size() const { return size_; }
+        std::string_view view() const { return { data_, size_ }; }
+
+    private:
+        void release() noexcept;
+
+        const char* data_ = nullptr;
+        std::size_t size_ = 0;
+#ifdef _WIN32
+        void* file_handle_ = nullptr;
+        void* mapping_handle_ = nullptr;
+#else
+        int fd_ = -1;
+#endif
+    };
+}
@@ -0,0 +1,102 @@
+#include "metrics.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace metrics
+{
+    uint64_t now_us() {
+        const auto since_epoch = std::chrono::system_clock::now().time_since_epoch();
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(since_epoch).count());
+    }
+
+    size_t LatencyHistogram::bucket_of(uint64_t value) {
+        if (value < kSubCount) {
+            return static_cast<size_t>(value);
+        }
+        // value >> shift попадает в [kSubCount, 2 * kSubCount)
+        const unsigned shift = static_cast<unsigned>(std::bit_width(value)) - kSubBits - 1;
+        return (shift + 1) * kSubCount + static_cast<size_t>((value >> shift) - kSubCount);
+    }
+
+    uint64_t LatencyHistogram::upper_bound_of(size_t bucket) {
+        if (bucket < kSubCount) {
+            return bucket;
+        }
+        const unsigned shift = static_cast<unsigned>(bucket / kSubCount) - 1;
+        const uint64_t sub = bucket % kSubCount + kSubCount;
+        return ((sub + 1) << shift) - 1;
+    }
+
+    void LatencyHistogram::record(uint64_t value) {
+        buckets_[bucket_of(value)].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(value, std::memory_order_relaxed);
+
+        uint64_t current = min_.load(std::memory_order_relaxed);
+        while (value < current && !min_.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+        }
+        current = max_.load(std::memory_order_relaxed);
+        while (value > current && !max_.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    double LatencyHistogram::mean() const {
+        const uint64_t n = count();
+        return n == 0 ? 0.0 : static_cast<double>(sum_.load(std::memory_order_relaxed)) / static_cast<double>(n);
+    }
+
+    uint64_t LatencyHistogram::percentile(double p) const {
+        const uint64_t n = count();
+        if (n == 0) {
+            return 0;
+        }
+        const auto target = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(p / 100.0 * static_cast<double>(n))));
+        uint64_t seen = 0;
+        for (size_t bucket = 0; bucket < kBucketCount; ++bucket) {
+            seen += buckets_[bucket].load(std::memory_order_relaxed);
+            if (seen >= target) {
+                return std::min(upper_bound_of(bucket), max());
+            }
+        }
+        return max();
+    }
+
+    nlohmann::json LatencyHistogram::to_json() const {
+        const uint64_t n = count();
+        return {
+            { "count", n },
+            { "min", n == 0 ? 0 : min_.load(std::memory_order_relaxed) },
+            { "mean", mean() },
+            { "p50", percentile(50) },
+            { "p90", percentile(90) },
+            { "p99", percentile(99) },
+            { "p999", percentile(99.9) },
+            { "max", max() },
+        };
+    }
+
+    void write_metrics_file(const std::string& path, const nlohmann::json& metrics) {
+        const std::string tmp_path = path + ".tmp";
+        {
+            std::ofstream ofs(tmp_path, std::ios::binary | std::ios::trunc);
+            if (!ofs.is_open()) {
+                std::cerr << "Error: Could not open metrics file " << tmp_path << std::endl;
+                return;
+            }
+            ofs << metrics.dump(2) << '\n';
+            if (!ofs) {
+                std::cerr << "Error: Could not write metrics file " << tmp_path << std::endl;
+                return;
+            }
+        }
+        std::error_code ec;
+        std::filesystem::rename(tmp_path, path, ec);
+        if (ec) {
+            std::cerr << "Error: Could not replace metrics file " << path << ": " << ec.message() << std::endl;
+        }
+    }
+}
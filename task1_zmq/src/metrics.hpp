@@ -0,0 +1,55 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <nlohmann/json.hpp>
+
+namespace metrics
+{
+    // Микросекунды от эпохи UNIX по system_clock - метка времени публикации в заголовке сообщения
+    uint64_t now_us();
+
+    // Гистограмма задержек в духе HdrHistogram: значения до 32 хранятся точно,
+    // далее каждый диапазон [2^k, 2^(k+1)) делится на 32 равные части (погрешность не больше 1/32).
+    // Запись без блокировок: один поток пишет, любой поток может читать приблизительный срез
+    class LatencyHistogram
+    {
+    public:
+        void record(uint64_t value);
+
+        template <typename Rep, typename Period>
+        void record(std::chrono::duration<Rep, Period> elapsed) {
+            const auto us = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+            record(us > 0 ? static_cast<uint64_t>(us) : 0);
+        }
+
+        uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+        uint64_t max() const { return max_.load(std::memory_order_relaxed); }
+        double mean() const;
+        // Верхняя граница диапазона, в который попадает перцентиль p (0..100)
+        uint64_t percentile(double p) const;
+
+        // count, min, mean, p50, p90, p99, p999, max
+        nlohmann::json to_json() const;
+
+    private:
+        static constexpr unsigned kSubBits = 5;
+        static constexpr size_t kSubCount = size_t{ 1 } << kSubBits;
+        static constexpr size_t kBucketCount = (64 - kSubBits + 1) * kSubCount;
+
+        static size_t bucket_of(uint64_t value);
+        static uint64_t upper_bound_of(size_t bucket);
+
+        std::array<std::atomic<uint64_t>, kBucketCount> buckets_{};
+        std::atomic<uint64_t> count_{ 0 };
+        std::atomic<uint64_t> sum_{ 0 };
+        std::atomic<uint64_t> min_{ UINT64_MAX };
+        std::atomic<uint64_t> max_{ 0 };
+    };
+
+    // Атомарная замена файла метрик: запись во временный файл и переименование.
+    // Ошибки выводятся в std::cerr, работа продолжается
+    void write_metrics_file(const std::string& path, const nlohmann::json& metrics);
+}
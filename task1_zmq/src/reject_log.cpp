@@ -0,0 +1,152 @@
+#include "reject_log.hpp"
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+
+namespace data_loader
+{
+    namespace {
+        // Буфер строк сбрасывается в файл, когда превышает этот размер
+        constexpr size_t kFlushThreshold = 64 * 1024;
+
+        void append_csv_field(std::string& out, std::string_view text) {
+            if (text.find_first_of(",\"\n\r") == std::string_view::npos) {
+                out.append(text);
+                return;
+            }
+            out.push_back('"');
+            for (char c : text) {
+                if (c == '"') {
+                    out.push_back('"');
+                }
+                out.push_back(c);
+            }
+            out.push_back('"');
+        }
+    }
+
+    std::string_view reject_reason_name(RejectReason reason) {
+        switch (reason) {
+        case RejectReason::Format: return "format";
+        case RejectReason::IdRange: return "id_range";
+        case RejectReason::DateRange: return "date_range";
+        case RejectReason::DateValue: return "date_value";
+        case RejectReason::EmptyFio: return "empty_fio";
+        }
+        return "unknown";
+    }
+
+    std::string_view reject_reason_message(RejectReason reason) {
+        switch (reason) {
+        case RejectReason::Format: return "Parsing Error (Format): Invalid line format: ";
+        // Прежний текст: e.what() исключения std::stoul
+        case RejectReason::IdRange: return "Parsing Error (Exception): stoul in line: ";
+        case RejectReason::DateRange: return "Validation Error (Date): Invalid date format in line: ";
+        case RejectReason::DateValue: return "Validation Error (Date): Invalid date value in line: ";
+        case RejectReason::EmptyFio: return "Validation Error (FIO): FIO is empty or contains only spaces in line: ";
+        }
+        return "Parsing Error: ";
+    }
+
+    RejectLog::RejectLog(std::string path, std::size_t capacity)
+        : path_(std::move(path)), queue_(capacity) {
+        if (!path_.empty()) {
+            std::error_code ec;
+            const bool fresh = !std::filesystem::exists(path_, ec) || std::filesystem::file_size(path_, ec) == 0;
+            out_ = std::fopen(path_.c_str(), "ab");
+            if (out_ == nullptr) {
+                throw std::runtime_error("Could not open reject file " + path_);
+            }
+            if (fresh) {
+                std::fputs("file,line,reason,text\n", out_);
+            }
+        }
+        writer_ = std::thread(&RejectLog::writerLoop, this);
+    }
+
+    RejectLog::~RejectLog() {
+        queue_.close();
+        if (writer_.joinable()) {
+            writer_.join();
+        }
+        if (out_ != nullptr) {
+            std::fclose(out_);
+        }
+    }
+
+    bool RejectLog::push(RejectedLine&& line) {
+        if (!queue_.try_push(std::move(line))) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        pushed_.fetch_add(1, std::memory_order_release);
+        return true;
+    }
+
+    void RejectLog::flush() {
+        const uint64_t target = pushed_.load(std::memory_order_acquire);
+        for (uint64_t written = written_.load(std::memory_order_acquire); written < target;
+            written = written_.load(std::memory_order_acquire)) {
+            written_.wait(written, std::memory_order_acquire);
+        }
+    }
+
+    void RejectLog::writerLoop() {
+        std::string buffer;
+        buffer.reserve(kFlushThreshold + 4096);
+        uint64_t formatted = 0;
+
+        // Счётчик written_ растёт только после записи в файл, чтобы flush() видел данные на диске
+        auto write_out = [&] {
+            if (!buffer.empty()) {
+                if (out_ != nullptr) {
+                    std::fwrite(buffer.data(), 1, buffer.size(), out_);
+                    std::fflush(out_);
+                }
+                else {
+                    std::cerr.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                    std::cerr.flush();
+                }
+                buffer.clear();
+            }
+            written_.store(formatted, std::memory_order_release);
+            written_.notify_all();
+        };
+
+        // Пустая очередь: накопленное записывается, поток спит до новой записи или закрытия очереди
+        for (;;) {
+            auto line = queue_.try_pop();
+            if (!line) {
+                write_out();
+                line = queue_.wait_pop();
+                if (!line) {
+                    break;
+                }
+            }
+
+            if (out_ != nullptr) {
+                append_csv_field(buffer, line->file);
+                buffer.push_back(',');
+                buffer += std::to_string(line->line);
+                buffer.push_back(',');
+                buffer += reject_reason_name(line->reason);
+                buffer.push_back(',');
+                append_csv_field(buffer, line->text);
+                buffer.push_back('\n');
+            }
+            else {
+                buffer += reject_reason_message(line->reason);
+                buffer += line->text;
+                buffer += " (";
+                buffer += line->file;
+                buffer.push_back(':');
+                buffer += std::to_string(line->line);
+                buffer += ")\n";
+            }
+            ++formatted;
+            if (buffer.size() >= kFlushThreshold) {
+                write_out();
+            }
+        }
+    }
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "spsc_queue.hpp"
+
+namespace data_loader
+{
+    // Причина отбраковки строки входного файла
+    enum class RejectReason : uint8_t { Format, IdRange, DateRange, DateValue, EmptyFio };
+    inline constexpr std::size_t kRejectReasonCount = 5;
+
+    // Короткое имя для файла отбраковки и метрик: format, id_range, date_range, date_value, empty_fio
+    std::string_view reject_reason_name(RejectReason reason);
+    // Текст сообщения об ошибке, как в прежнем построчном выводе в std::cerr
+    std::string_view reject_reason_message(RejectReason reason);
+
+    struct RejectedLine {
+        std::string file;
+        std::size_t line = 0;   // номер строки в файле, с единицы
+        RejectReason reason = RejectReason::Format;
+        std::string text;
+    };
+
+    // Асинхронный журнал отбракованных строк. Потоки разбора кладут записи в ограниченный
+    // кольцевой буфер без блокировок и не ждут вывода; фоновый поток пишет их в файл CSV
+    // "file,line,reason,text" (дописывается, заголовок - в новый файл) или, при пустом пути,
+    // в std::cerr. Переполнение буфера не тормозит разбор: лишние записи только подсчитываются
+    class RejectLog
+    {
+    public:
+        // Бросает std::runtime_error, если файл не удалось открыть
+        explicit RejectLog(std::string path = {}, std::size_t capacity = 65536);
+        ~RejectLog();
+
+        RejectLog(const RejectLog&) = delete;
+        RejectLog& operator=(const RejectLog&) = delete;
+
+        // false, если буфер заполнен и запись отброшена
+        bool push(RejectedLine&& line);
+        // Ждёт, пока фоновый поток запишет всё, что было добавлено до вызова
+        void flush();
+
+        uint64_t written() const { return written_.load(std::memory_order_relaxed); }
+        uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+        const std::string& path() const { return path_; }
+
+    private:
+        void writerLoop();
+
+        std::string path_;
+        std::FILE* out_ = nullptr;
+        util::MpscQueue<RejectedLine> queue_;
+        std::atomic<uint64_t> pushed_{ 0 };
+        std::atomic<uint64_t> written_{ 0 };
+        std::atomic<uint64_t> dropped_{ 0 };
+        std::thread writer_;
+    };
+}
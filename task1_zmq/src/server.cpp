@@ -1,32 +1,402 @@
 #include "server.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <functional>
 #include <iostream>
+#include <iterator>
+#include <map>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <zmq_addon.hpp>
+
+#include "dir_watcher.hpp"
+#include "kway_merge.hpp"
+#include "listing_writer.hpp"
 
 namespace server {
+    namespace {
+        constexpr auto kPollTimeout = std::chrono::milliseconds(100);
+        constexpr auto kMaxWait = std::chrono::milliseconds(500);
+        //   ,    
+        constexpr auto kIdleWait = std::chrono::milliseconds(1);
+        constexpr auto kStatsInterval = std::chrono::seconds(30);
+        //    :       ,   ROUTER
+        // ,       ZMQ . ,  
+        //   kSnapshotSendTimeout,     
+        constexpr int kStreamedSnapshotHwm = 64;
+        constexpr auto kSnapshotSendTimeout = std::chrono::seconds(30);
+        // ,         
+        constexpr size_t kProxyBatch = 1024;
+
+        using TopicSets = std::map<std::string, data_loader::StudentSet>;
+        using TopicDeltas = std::map<std::string, data_loader::StudentDelta>;
+
+        zmq::message_t make_frame(std::string_view data) {
+            return zmq::message_t(data.data(), data.size());
+        }
+
+        //    ,   owner,  .
+        // ZMQ     ,     
+        zmq::message_t make_shared_frame(std::shared_ptr<const void> owner, std::string_view data) {
+            auto* hint = new std::shared_ptr<const void>(std::move(owner));
+            return zmq::message_t(const_cast<char*>(data.data()), data.size(),
+                [](void*, void* h) { delete static_cast<std::shared_ptr<const void>*>(h); }, hint);
+        }
+
+        //    ,   
+        zmq::message_t make_owned_frame(std::string&& data) {
+            auto* owned = new std::string(std::move(data));
+            return zmq::message_t(owned->data(), owned->size(),
+                [](void*, void* h) { delete static_cast<std::string*>(h); }, owned);
+        }
+
+        zmq::message_t make_header(wire::Format format, wire::MessageKind kind, uint64_t sequence, uint64_t source) {
+            return make_frame(wire::encode_header({ wire::kVersion, format, kind, sequence, metrics::now_us(), source }));
+        }
+
+        TopicSets split_by_topic(const data_loader::StudentSet& students) {
+            TopicSets topics;
+            for (const auto& student : students) {
+                topics[std::string(wire::topic_of(student.fio))].insert(student);
+            }
+            return topics;
+        }
+
+        TopicDeltas split_by_topic(const data_loader::StudentDelta& delta) {
+            TopicDeltas topics;
+            for (const auto& student : delta.added) {
+                topics[std::string(wire::topic_of(student.fio))].added.push_back(student);
+            }
+            for (const auto& student : delta.removed) {
+                topics[std::string(wire::topic_of(student.fio))].removed.push_back(student);
+            }
+            return topics;
+        }
+
+        //       chunk_size .
+        //    sink,        finish()
+        class ChunkEncoder
+        {
+        public:
+            using Sink = std::function<void(std::string&&)>;
+
+            ChunkEncoder(size_t chunk_size, wire::Format format, Sink sink = {})
+                : chunk_size_(std::max<size_t>(chunk_size, 1)), format_(format), sink_(std::move(sink)) {
+            }
+
+            void add(domain::Student&& student) {
+                pending_.push_back(std::move(student));
+                if (pending_.size() >= chunk_size_) {
+                    flush();
+                }
+            }
+
+            //      ,     
+            std::vector<std::string> finish() {
+                if (!pending_.empty() || chunk_count_ == 0) {
+                    flush();
+                }
+                return std::move(chunks_);
+            }
+
+        private:
+            void flush() {
+                std::string chunk = wire::encode_students(pending_, format_);
+                pending_.clear();
+                ++chunk_count_;
+                if (sink_) {
+                    sink_(std::move(chunk));
+                }
+                else {
+                    chunks_.push_back(std::move(chunk));
+                }
+            }
 
+            size_t chunk_size_;
+            wire::Format format_;
+            Sink sink_;
+            std::vector<domain::Student> pending_;
+            std::vector<std::string> chunks_;
+            size_t chunk_count_ = 0;
+        };
+    }
+
+
+    uint64_t Server::makeSourceId() {
+        std::random_device device;
+        std::seed_seq seed{ device(), device(), static_cast<unsigned>(metrics::now_us()) };
+        std::mt19937_64 rng(seed);
+        uint64_t id = 0;
+        while (id == 0) {
+            id = rng();
+        }
+        return id;
+    }
+
+    void Server::updateSnapshot(const std::map<std::string, data_loader::StudentSet>& topic_sets,
+        const std::map<std::string, uint64_t>& topic_sequences, const std::vector<std::string>& changed_topics) {
+        //        
+        auto next = std::make_shared<Snapshot>();
+        if (auto current = currentSnapshot()) {
+            next->topics = current->topics;
+        }
+        const auto start = std::chrono::steady_clock::now();
+        for (const auto& topic : changed_topics) {
+            auto topic_snapshot = std::make_shared<TopicSnapshot>();
+            topic_snapshot->sequence = topic_sequences.at(topic);
+
+            const auto& students = topic_sets.at(topic);
+            std::vector<domain::Student> sorted = students.to_students();
+            std::sort(sorted.begin(), sorted.end(), domain::Student::order{});
+
+            ChunkEncoder encoder(options.chunk_size, options.format);
+            for (auto& student : sorted) {
+                encoder.add(std::move(student));
+            }
+            topic_snapshot->chunks = encoder.finish();
+            next->topics[topic] = std::move(topic_snapshot);
+        }
+        server_metrics.encode_latency.record(std::chrono::steady_clock::now() - start);
+        storeSnapshot(std::move(next));
+    }
+
+    void Server::updateSnapshot(std::shared_ptr<const data_loader::SortedRunFile> students,
+        const std::map<std::string, uint64_t>& topic_sequences) {
+        //   : snapshotLoop       
+        auto next = std::make_shared<Snapshot>();
+        next->file = std::move(students);
+        for (const auto& [topic, sequence] : topic_sequences) {
+            auto topic_snapshot = std::make_shared<TopicSnapshot>();
+            topic_snapshot->sequence = sequence;
+            next->topics[topic] = std::move(topic_snapshot);
+        }
+        storeSnapshot(std::move(next));
+    }
+
+    void Server::storeSnapshot(std::shared_ptr<const Snapshot> next) {
+        {
+            std::lock_guard<std::mutex> lock(snapshot_mutex);
+            snapshot = std::move(next);
+        }
+        snapshot_ready.notify_all();
+    }
+
+    std::shared_ptr<const Server::Snapshot> Server::currentSnapshot() {
+        std::lock_guard<std::mutex> lock(snapshot_mutex);
+        return snapshot;
+    }
+
+
+    data_loader::StudentSet Server::loadStudents() {
+        const auto start = std::chrono::steady_clock::now();
+        data_loader::LoadOptions load_options;
+        load_options.threads = options.loader_threads;
+        load_options.use_cache = options.use_cache;
+        load_options.cache_path = options.cache_path;
+        load_options.reject_log = reject_log.get();
+        data_loader::LoadStats stats;
+        auto students = data_loader::load_all_students(*options.dir, load_options, &stats);
+        recordLoad(stats, students.size(), start);
+        return students;
+    }
+
+    data_loader::SortedRunFile Server::loadStudentsExternal() {
+        const auto start = std::chrono::steady_clock::now();
+        data_loader::ExternalOptions load_options;
+        load_options.memory_budget = options.memory_budget << 20;
+        load_options.spill_dir = options.spill_dir;
+        load_options.reject_log = reject_log.get();
+        data_loader::LoadStats stats;
+        auto students = data_loader::load_all_students_external(*options.dir, load_options, &stats);
+        recordLoad(stats, students.size(), start);
+        return students;
+    }
+
+    void Server::recordLoad(const data_loader::LoadStats& stats, size_t records, std::chrono::steady_clock::time_point start) {
+        server_metrics.load_latency.record(std::chrono::steady_clock::now() - start);
+
+        server_metrics.loads.fetch_add(1, std::memory_order_relaxed);
+        server_metrics.lines.store(stats.lines, std::memory_order_relaxed);
+        server_metrics.rejected_lines.store(stats.rejected, std::memory_order_relaxed);
+        server_metrics.records.store(records, std::memory_order_relaxed);
+        if (stats.cached_files > 0) {
+            std::cout << "Files taken from cache: " << stats.cached_files << " of " << stats.files << std::endl;
+        }
+        for (size_t i = 0; i < data_loader::kRejectReasonCount; ++i) {
+            server_metrics.rejected_by_reason[i].store(stats.rejected_by_reason[i], std::memory_order_relaxed);
+        }
+        //    :  -   
+        if (stats.rejected > 0) {
+            std::cout << "Rejected lines: " << stats.rejected << " of " << stats.lines << " (";
+            const char* separator = "";
+            for (size_t i = 0; i < data_loader::kRejectReasonCount; ++i) {
+                if (stats.rejected_by_reason[i] > 0) {
+                    std::cout << separator << data_loader::reject_reason_name(static_cast<data_loader::RejectReason>(i))
+                        << " " << stats.rejected_by_reason[i];
+                    separator = ", ";
+                }
+            }
+            std::cout << ")";
+            if (reject_log && !reject_log->path().empty()) {
+                std::cout << ", details in " << reject_log->path();
+            }
+            if (reject_log && reject_log->dropped() > 0) {
+                std::cout << ", " << reject_log->dropped() << " not logged (buffer full)";
+            }
+            std::cout << std::endl;
+        }
+    }
 
     void Server::serverLoop(std::atomic<bool>& running_flag) {
         try {
             zmq::socket_t publisher(zmq_context, zmq::socket_type::pub);
-            publisher.bind(options.url);
-            std::cout << "ZMQ PUB Server bound to: " << options.url << std::endl;
+            publisher.set(zmq::sockopt::sndhwm, options.sndhwm);
+            if (options.upstream_url.empty()) {
+                publisher.bind(options.url);
+                std::cout << "ZMQ PUB Server bound to: " << options.url << std::endl;
+            }
+            else {
+                //   :      XSUB
+                publisher.connect(options.upstream_url);
+                std::cout << "ZMQ PUB Server connected to proxy: " << options.upstream_url << std::endl;
+            }
+            std::cout << "Source id: " << source_id << std::endl;
 
-            auto students_set = data_loader::load_all_students(*options.dir);
-            std::vector<domain::Student> students_list(students_set.begin(), students_set.end());
-            std::cout << "Total unique students found: " << students_list.size() << std::endl;
+            try {
+                reject_log = std::make_unique<data_loader::RejectLog>(options.reject_file);
+            }
+            catch (const std::exception& e) {
+                //  ,    
+                std::cerr << "Reject Log Error: " << e.what() << std::endl;
+            }
+
+            //    ,       
+            data_loader::DirectoryWatcher watcher(*options.dir);
+
+            //   (  )    ,
+            //  ,    ,    -  
+            std::map<std::string, uint64_t> topic_sequences;
+            //         ,    students_set/topic_sets
+            const bool external = options.memory_budget > 0;
+            data_loader::StudentSet students_set;
+            TopicSets topic_sets;
+            //    :  ,       
+            std::shared_ptr<const data_loader::SortedRunFile> students_file;
+            if (external) {
+                std::cout << "Memory budget: " << options.memory_budget << " MiB, sorted runs spilled to "
+                    << (options.spill_dir.empty() ? std::filesystem::temp_directory_path().string() : options.spill_dir) << std::endl;
+                students_file = std::make_shared<const data_loader::SortedRunFile>(loadStudentsExternal());
+                std::cout << "Total unique students found: " << students_file->size() << std::endl;
+                students_file->for_each([&](domain::Student&& student) {
+                    topic_sequences.try_emplace(std::string(wire::topic_of(student.fio)), 1);
+                });
+                updateSnapshot(students_file, topic_sequences);
+            }
+            else {
+                students_set = loadStudents();
+                std::cout << "Total unique students found: " << students_set.size() << std::endl;
+                topic_sets = split_by_topic(students_set);
+                std::vector<std::string> all_topics;
+                for (const auto& [topic, students] : topic_sets) {
+                    topic_sequences[topic] = 1;
+                    all_topics.push_back(topic);
+                }
+                updateSnapshot(topic_sets, topic_sequences, all_topics);
+            }
+            std::cout << "Topics: " << topic_sequences.size() << std::endl;
+            auto last_publish = std::chrono::steady_clock::now();
+            auto next_metrics = last_publish;
 
-            nlohmann::json j_students = students_list;
-            std::string message_data = j_students.dump();
+            // Heartbeat -      
+            const auto publish_interval = std::chrono::milliseconds(options.publish_interval_ms);
 
             //   
             while (running_flag) {
-                std::this_thread::sleep_for(std::chrono::milliseconds(100));
-                zmq::message_t message(message_data.begin(), message_data.end());
-                publisher.send(message, zmq::send_flags::none);
+                if (!options.metrics_file.empty() && std::chrono::steady_clock::now() >= next_metrics) {
+                    metrics::write_metrics_file(options.metrics_file, serverMetricsJson());
+                    next_metrics = std::chrono::steady_clock::now() + std::chrono::seconds(options.metrics_interval);
+                }
+
+                //         (heartbeat, );
+                //   kMaxWait,    
+                auto deadline = last_publish + publish_interval;
+                if (!options.metrics_file.empty()) {
+                    deadline = std::min(deadline, next_metrics);
+                }
+                const auto timeout = std::clamp(std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()),
+                    std::chrono::milliseconds(1), kMaxWait);
+
+                if (watcher.wait_for_change(timeout)) {
+                    data_loader::StudentDelta delta;
+                    size_t total = 0;
+                    if (external) {
+                        auto reloaded = loadStudentsExternal();
+                        delta = data_loader::diff_students(*students_file, reloaded);
+                        if (!delta.empty()) {
+                            students_file = std::make_shared<const data_loader::SortedRunFile>(std::move(reloaded));
+                        }
+                        total = students_file->size();
+                    }
+                    else {
+                        auto reloaded = loadStudents();
+                        delta = data_loader::diff_students(students_set, reloaded);
+                        if (!delta.empty()) {
+                            students_set = std::move(reloaded);
+                        }
+                        total = students_set.size();
+                    }
+                    if (!delta.empty()) {
+                        std::vector<std::string> changed_topics;
+                        TopicDeltas topic_deltas = split_by_topic(delta);
+                        for (auto& [topic, topic_delta] : topic_deltas) {
+                            if (!external) {
+                                data_loader::apply_delta(topic_sets[topic], topic_delta);
+                            }
+                            ++topic_sequences[topic];
+                            changed_topics.push_back(topic);
+                        }
+                        if (external) {
+                            updateSnapshot(students_file, topic_sequences);
+                        }
+                        else {
+                            updateSnapshot(topic_sets, topic_sequences, changed_topics);
+                        }
 
-                std::cout << "Published student data (" << message_data.size()
-                    << " bytes). Waiting for next update..." << std::endl;
+                        // : , ,  ,  .
+                        //          ZMQ
+                        size_t bytes = 0;
+                        for (const auto& [topic, topic_delta] : topic_deltas) {
+                            std::string added = wire::encode_students(topic_delta.added, options.format);
+                            std::string removed = wire::encode_students(topic_delta.removed, options.format);
+                            bytes += added.size() + removed.size();
+                            std::vector<zmq::message_t> frames;
+                            frames.push_back(make_frame(topic));
+                            frames.push_back(make_header(options.format, wire::MessageKind::Delta, topic_sequences[topic], source_id));
+                            frames.push_back(make_owned_frame(std::move(added)));
+                            frames.push_back(make_owned_frame(std::move(removed)));
+                            zmq::send_multipart(publisher, frames);
+                        }
+                        last_publish = std::chrono::steady_clock::now();
+                        server_metrics.deltas_published.fetch_add(topic_deltas.size(), std::memory_order_relaxed);
+                        server_metrics.bytes_published.fetch_add(bytes, std::memory_order_relaxed);
 
-                std::this_thread::sleep_for(std::chrono::seconds(5));
+                        std::cout << "Published delta for " << topic_deltas.size() << " topic(s) (+" << delta.added.size()
+                            << " / -" << delta.removed.size() << ", total " << total
+                            << ", " << bytes << " bytes)." << std::endl;
+                    }
+                }
+
+                if (std::chrono::steady_clock::now() - last_publish >= publish_interval) {
+                    for (const auto& [topic, sequence] : topic_sequences) {
+                        std::vector<zmq::message_t> frames;
+                        frames.push_back(make_frame(topic));
+                        frames.push_back(make_header(options.format, wire::MessageKind::Heartbeat, sequence, source_id));
+                        zmq::send_multipart(publisher, frames);
+                    }
+                    server_metrics.heartbeats_published.fetch_add(topic_sequences.size(), std::memory_order_relaxed);
+                    last_publish = std::chrono::steady_clock::now();
+                }
             }
         }
         catch (const zmq::error_t& e) {
@@ -35,39 +405,388 @@ namespace server {
         catch (const std::exception& e) {
             std::cerr << "Standard Exception (Server): " << e.what() << std::endl;
         }
+        if (!options.metrics_file.empty()) {
+            metrics::write_metrics_file(options.metrics_file, serverMetricsJson());
+        }
+    }
+
+
+    void Server::snapshotLoop(std::atomic<bool>& running_flag) {
+        try {
+            zmq::socket_t router(zmq_context, zmq::socket_type::router);
+            router.set(zmq::sockopt::linger, 0);
+            // ROUTER     HWM,       .
+            // ,   ,    :  router_mandatory 
+            //     (  kSnapshotSendTimeout)  
+            const bool streamed = options.memory_budget > 0;
+            router.set(zmq::sockopt::sndhwm, streamed ? kStreamedSnapshotHwm : 0);
+            if (streamed) {
+                router.set(zmq::sockopt::router_mandatory, 1);
+                router.set(zmq::sockopt::sndtimeo, static_cast<int>(std::chrono::milliseconds(kSnapshotSendTimeout).count()));
+            }
+            router.bind(options.snapshot_urls.front());
+            std::cout << "ZMQ ROUTER snapshot socket bound to: " << options.snapshot_urls.front() << std::endl;
+
+            while (running_flag) {
+                //   ,     
+                {
+                    std::unique_lock<std::mutex> lock(snapshot_mutex);
+                    if (!snapshot_ready.wait_for(lock, kPollTimeout, [this] { return snapshot != nullptr; })) {
+                        continue;
+                    }
+                }
+
+                zmq::pollitem_t items[] = { { router.handle(), 0, ZMQ_POLLIN, 0 } };
+                zmq::poll(items, 1, kPollTimeout);
+                if (!(items[0].revents & ZMQ_POLLIN)) {
+                    continue;
+                }
+
+                // : , ICANHAZ?,    
+                std::vector<zmq::message_t> request;
+                if (!zmq::recv_multipart(router, std::back_inserter(request))) {
+                    continue;
+                }
+                if (request.size() < 2 || request[1].to_string_view() != wire::kSnapshotRequest) {
+                    std::cerr << "Protocol Error: Unexpected snapshot request" << std::endl;
+                    continue;
+                }
+                std::set<std::string> requested;
+                for (size_t i = 2; i < request.size(); ++i) {
+                    requested.insert(request[i].to_string());
+                }
+
+                //  -     , ,   :
+                // SnapshotBegin,    , SnapshotEnd   
+                auto current = currentSnapshot();
+                const std::string identity = request[0].to_string();
+                auto send_message = [&](std::string_view topic, wire::MessageKind kind, uint64_t sequence, zmq::message_t payload) {
+                    std::vector<zmq::message_t> frames;
+                    frames.push_back(make_frame(identity));
+                    frames.push_back(make_frame(topic));
+                    frames.push_back(make_header(options.format, kind, sequence, source_id));
+                    frames.push_back(std::move(payload));
+                    //  sndtimeo:    
+                    if (!zmq::send_multipart(router, frames)) {
+                        throw std::runtime_error("snapshot send timed out");
+                    }
+                };
+
+                const auto start = std::chrono::steady_clock::now();
+                size_t topic_count = 0;
+                size_t chunk_count = 0;
+                size_t bytes = 0;
+                try {
+                    send_message("", wire::MessageKind::SnapshotBegin, 0, zmq::message_t());
+                    if (current->file) {
+                        //     ,     ;    
+                        //   .   ,    
+                        std::map<std::string, ChunkEncoder, std::less<>> encoders;
+                        for (const auto& [topic, topic_snapshot] : current->topics) {
+                            if (!requested.empty() && !requested.contains(topic)) {
+                                continue;
+                            }
+                            ++topic_count;
+                            encoders.try_emplace(topic, options.chunk_size, options.format,
+                                [&, name = topic, sequence = topic_snapshot->sequence](std::string&& chunk) {
+                                    bytes += chunk.size();
+                                    ++chunk_count;
+                                    send_message(name, wire::MessageKind::Snapshot, sequence, make_owned_frame(std::move(chunk)));
+                                });
+                        }
+                        current->file->for_each([&](domain::Student&& student) {
+                            const auto it = encoders.find(wire::topic_of(student.fio));
+                            if (it != encoders.end()) {
+                                it->second.add(std::move(student));
+                            }
+                        });
+                        for (auto& [topic, encoder] : encoders) {
+                            encoder.finish();
+                        }
+                    }
+                    else {
+                        for (const auto& [topic, topic_snapshot] : current->topics) {
+                            if (!requested.empty() && !requested.contains(topic)) {
+                                continue;
+                            }
+                            ++topic_count;
+                            for (const auto& chunk : topic_snapshot->chunks) {
+                                //  :       
+                                send_message(topic, wire::MessageKind::Snapshot, topic_snapshot->sequence,
+                                    make_shared_frame(topic_snapshot, chunk));
+                                ++chunk_count;
+                                bytes += chunk.size();
+                            }
+                        }
+                    }
+                    send_message("", wire::MessageKind::SnapshotEnd, chunk_count, zmq::message_t());
+                }
+                catch (const std::exception& e) {
+                    //  ,       :  SnapshotEnd 
+                    //       
+                    std::cerr << "Snapshot Error: " << e.what() << ", response aborted after " << chunk_count
+                        << " chunk(s)" << std::endl;
+                    continue;
+                }
+                server_metrics.snapshot_latency.record(std::chrono::steady_clock::now() - start);
+                server_metrics.snapshots_served.fetch_add(1, std::memory_order_relaxed);
+                server_metrics.snapshot_chunks.fetch_add(chunk_count, std::memory_order_relaxed);
+                server_metrics.snapshot_bytes.fetch_add(bytes, std::memory_order_relaxed);
+
+                std::cout << "Sent snapshot of " << topic_count << " topic(s) in " << chunk_count << " chunk(s) ("
+                    << bytes << " bytes, " << wire::format_name(options.format) << ")." << std::endl;
+            }
+        }
+        catch (const zmq::error_t& e) {
+            std::cerr << "ZMQ Error (Snapshot): " << e.what() << std::endl;
+        }
+        catch (const std::exception& e) {
+            std::cerr << "Standard Exception (Snapshot): " << e.what() << std::endl;
+        }
     }
 
 
     void Server::clientLoop(std::atomic<bool>& running_flag) {
+        ClientPipeline& pipe = *pipeline;
         try {
+            //     : ,   
+            //  ,       .
+            //        
             zmq::socket_t subscriber(zmq_context, zmq::socket_type::sub);
             subscriber.connect(options.url);
             std::cout << "ZMQ SUB Client connected to: " << options.url << std::endl;
-            subscriber.set(zmq::sockopt::subscribe, "");
+            if (options.topics.empty()) {
+                subscriber.set(zmq::sockopt::subscribe, "");
+            }
+            for (const auto& topic : options.topics) {
+                subscriber.set(zmq::sockopt::subscribe, topic);
+                std::cout << "Subscribed to topic: " << topic << std::endl;
+            }
+
+            //       (DEALER   
+            //     );     
+            //     
+            struct SnapshotSource {
+                zmq::socket_t socket;
+                uint64_t id = 0;
+                bool pending = false;
+                bool active = false;
+                bool failed = false;
+                uint64_t chunks = 0;
+                std::map<std::string, uint64_t> incoming_sequences;
+            };
+            std::vector<SnapshotSource> sources;
+            for (const auto& snapshot_url : options.snapshot_urls) {
+                SnapshotSource& source = sources.emplace_back();
+                source.socket = zmq::socket_t(zmq_context, zmq::socket_type::dealer);
+                source.socket.set(zmq::sockopt::linger, 0);
+                source.socket.connect(snapshot_url);
+            }
+
+            //        ;
+            //       
+            std::map<uint64_t, size_t> source_index;
+            std::vector<std::map<std::string, uint64_t>> topic_sequences(sources.size());
+            // ,        
+            std::set<uint64_t> unknown_sources;
+            size_t snapshots_pending = 0;
+            bool round_failed = false;
+            bool have_state = false;
+            uint64_t generation = 0;
+            auto next_report = std::chrono::steady_clock::now() + kStatsInterval;
+            auto next_metrics = std::chrono::steady_clock::now();
+
+            //   ->     
+            auto record_receive = [&](const std::vector<zmq::message_t>& frames, const wire::Header& header) {
+                const uint64_t now = metrics::now_us();
+                pipe.publish_latency.record(now > header.timestamp_us ? now - header.timestamp_us : 0);
+                for (const auto& frame : frames) {
+                    pipe.bytes_received.fetch_add(frame.size(), std::memory_order_relaxed);
+                }
+            };
+
+            //     (ZMQ    ),
+            //   :       
+            auto forward = [&](ClientMessage&& message, size_t source) {
+                message.generation = generation;
+                message.source = source;
+                message.received = std::chrono::steady_clock::now();
+                while (!pipe.messages.try_push(std::move(message))) {
+                    pipe.backpressure_waits.fetch_add(1, std::memory_order_relaxed);
+                    if (!running_flag) {
+                        return;
+                    }
+                    std::this_thread::sleep_for(kIdleWait);
+                }
+                pipe.received.fetch_add(1, std::memory_order_relaxed);
+                const uint64_t depth = pipe.messages.size();
+                if (depth > pipe.max_depth.load(std::memory_order_relaxed)) {
+                    pipe.max_depth.store(depth, std::memory_order_relaxed);
+                }
+            };
+
+            //    ;  ,    
+            auto finish_snapshot = [&](SnapshotSource& source, bool complete) {
+                if (!source.pending) {
+                    return;
+                }
+                source.pending = false;
+                source.active = false;
+                round_failed = round_failed || !complete;
+                if (--snapshots_pending > 0 || round_failed) {
+                    return;
+                }
+                source_index.clear();
+                for (size_t i = 0; i < sources.size(); ++i) {
+                    source_index[sources[i].id] = i;
+                    topic_sequences[i] = std::move(sources[i].incoming_sequences);
+                    sources[i].incoming_sequences.clear();
+                }
+                have_state = true;
+            };
+
+            auto receive_snapshot = [&](SnapshotSource& source, size_t index) {
+                std::vector<zmq::message_t> frames;
+                zmq::recv_multipart(source.socket, std::back_inserter(frames));
+
+                auto header = frames.size() != 3 ? std::nullopt : wire::decode_header(frames[1].to_string_view());
+                if (!header || header->version != wire::kVersion) {
+                    std::cerr << "Protocol Error: Unsupported snapshot message" << std::endl;
+                    pipe.rejected_messages.fetch_add(1, std::memory_order_relaxed);
+                    source.failed = true;
+                    return;
+                }
+                record_receive(frames, *header);
+
+                if (header->kind == wire::MessageKind::SnapshotBegin) {
+                    source.id = header->source;
+                    source.active = true;
+                    source.failed = false;
+                    source.chunks = 0;
+                    source.incoming_sequences.clear();
+                    forward({ .kind = wire::MessageKind::SnapshotBegin }, index);
+                }
+                else if (header->kind == wire::MessageKind::Snapshot && source.active && header->source == source.id) {
+                    ++source.chunks;
+                    source.incoming_sequences[frames[0].to_string()] = header->sequence;
+                    forward({ .kind = wire::MessageKind::Snapshot, .topic = frames[0].to_string(), .sequence = header->sequence,
+                        .format = header->format, .payload = std::move(frames[2]) }, index);
+                }
+                else if (header->kind == wire::MessageKind::SnapshotEnd && source.active) {
+                    if (source.failed || header->sequence != source.chunks) {
+                        std::cerr << "Protocol Error: Incomplete snapshot from " << options.snapshot_urls[index] << " ("
+                            << source.chunks << " of " << header->sequence << " chunks), retrying" << std::endl;
+                        finish_snapshot(source, false);
+                        return;
+                    }
+                    forward({ .kind = wire::MessageKind::SnapshotEnd, .sequence = header->sequence }, index);
+                    finish_snapshot(source, true);
+                }
+                else {
+                    std::cerr << "Protocol Error: Unexpected snapshot message" << std::endl;
+                    pipe.rejected_messages.fetch_add(1, std::memory_order_relaxed);
+                    source.failed = true;
+                    if (header->kind == wire::MessageKind::SnapshotEnd) {
+                        finish_snapshot(source, false);
+                    }
+                }
+            };
+
+            std::vector<zmq::pollitem_t> items(sources.size() + 1);
+            for (size_t i = 0; i < sources.size(); ++i) {
+                items[i] = { sources[i].socket.handle(), 0, ZMQ_POLLIN, 0 };
+            }
 
             //   
             while (running_flag) {
-                zmq::message_t received_message;
-                auto result = subscriber.recv(received_message, zmq::recv_flags::none);
+                //        
+                if (have_state && pipe.failed_generation.load(std::memory_order_acquire) == generation) {
+                    std::cerr << "Decoded state is inconsistent. Requesting snapshot..." << std::endl;
+                    have_state = false;
+                }
 
-                if (result.has_value()) {
-                    std::string message_data(static_cast<char*>(received_message.data()), received_message.size());
-                    std::cout << "\nReceived new data batch (" << message_data.size() << " bytes)." << std::endl;
+                //   -      
+                if (!have_state && snapshots_pending == 0) {
+                    for (auto& source : sources) {
+                        std::vector<zmq::message_t> request;
+                        request.push_back(make_frame(wire::kSnapshotRequest));
+                        for (const auto& topic : options.topics) {
+                            request.push_back(make_frame(topic));
+                        }
+                        zmq::send_multipart(source.socket, request);
+                        source.pending = true;
+                        source.failed = false;
+                    }
+                    snapshots_pending = sources.size();
+                    round_failed = false;
+                    //        
+                    generation = pipe.generation.fetch_add(1, std::memory_order_acq_rel) + 1;
+                }
 
-                    std::vector<domain::Student> students;
-                    try {
-                        nlohmann::json j = nlohmann::json::parse(message_data);
-                        students = j.get<std::vector<domain::Student>>();
+                if (std::chrono::steady_clock::now() >= next_report) {
+                    reportPipeline();
+                    next_report = std::chrono::steady_clock::now() + kStatsInterval;
+                }
+                if (!options.metrics_file.empty() && std::chrono::steady_clock::now() >= next_metrics) {
+                    metrics::write_metrics_file(options.metrics_file, clientMetricsJson());
+                    next_metrics = std::chrono::steady_clock::now() + std::chrono::seconds(options.metrics_interval);
+                }
+
+                items.back() = { subscriber.handle(), 0, static_cast<short>(have_state ? ZMQ_POLLIN : 0), 0 };
+                zmq::poll(items.data(), items.size(), kPollTimeout);
+
+                for (size_t i = 0; i < sources.size(); ++i) {
+                    if (items[i].revents & ZMQ_POLLIN) {
+                        receive_snapshot(sources[i], i);
                     }
-                    catch (const std::exception& e) {
-                        std::cerr << "JSON Deserialization Error: " << e.what() << std::endl;
+                }
+
+                if (have_state && (items.back().revents & ZMQ_POLLIN)) {
+                    std::vector<zmq::message_t> frames;
+                    zmq::recv_multipart(subscriber, std::back_inserter(frames));
+
+                    auto header = frames.size() < 2 ? std::nullopt : wire::decode_header(frames[1].to_string_view());
+                    if (!header || header->version != wire::kVersion) {
+                        std::cerr << "Protocol Error: Unsupported message header, message skipped" << std::endl;
+                        pipe.rejected_messages.fetch_add(1, std::memory_order_relaxed);
                         continue;
                     }
+                    record_receive(frames, *header);
 
-                    std::sort(students.begin(), students.end(), [](const domain::Student& a, const domain::Student& b) {
-                        return a.fio < b.fio;
-                        });
-                    displayStudents(students);
+                    //   -   ( )  ,
+                    //    .     ;
+                    //      ,   
+                    auto source = source_index.find(header->source);
+                    if (source == source_index.end()) {
+                        if (unknown_sources.insert(header->source).second) {
+                            std::cerr << "Message from unknown source " << header->source << ". Requesting snapshot..." << std::endl;
+                            have_state = false;
+                        }
+                        else {
+                            pipe.unknown_source_dropped.fetch_add(1, std::memory_order_relaxed);
+                        }
+                        continue;
+                    }
+
+                    // ,   ,   
+                    const std::string topic = frames[0].to_string();
+                    uint64_t& sequence = topic_sequences[source->second][topic];
+                    //      
+                    if (header->sequence <= sequence) {
+                        continue;
+                    }
+
+                    if (header->kind == wire::MessageKind::Delta && header->sequence == sequence + 1 && frames.size() == 4) {
+                        sequence = header->sequence;
+                        forward({ .kind = wire::MessageKind::Delta, .topic = topic, .sequence = header->sequence,
+                            .format = header->format, .payload = std::move(frames[2]), .removed = std::move(frames[3]) }, source->second);
+                    }
+                    else {
+                        //  :     
+                        std::cerr << "Sequence gap detected for topic " << topic << " (have #" << sequence << ", got #"
+                            << header->sequence << "). Requesting snapshot..." << std::endl;
+                        have_state = false;
+                    }
                 }
             }
         }
@@ -77,25 +796,362 @@ namespace server {
         catch (const std::exception& e) {
             std::cerr << "Standard Exception (Client): " << e.what() << std::endl;
         }
+        pipe.messages.close();
+    }
+
+    void Server::decodeLoop() {
+        ClientPipeline& pipe = *pipeline;
+
+        // ,   
+        struct SnapshotStream {
+            std::vector<std::vector<domain::Student>> runs;
+            size_t records = 0;
+            size_t bytes = 0;
+        };
+
+        //     snapshot_urls:   (   ,  ),
+        //       
+        using Listing = std::shared_ptr<const std::vector<domain::Student>>;
+        const size_t source_count = options.snapshot_urls.size();
+        std::vector<Listing> listings(source_count);
+        std::vector<data_loader::ListingChanges> pending(source_count);
+        std::vector<SnapshotStream> incoming(source_count);
+        size_t sources_ready = 0;
+        size_t snapshot_bytes = 0;
+        uint64_t generation = 0;
+
+        //   :     
+        auto reset = [&] {
+            listings.assign(source_count, nullptr);
+            pending.assign(source_count, {});
+            incoming.assign(source_count, {});
+            sources_ready = 0;
+            snapshot_bytes = 0;
+        };
+
+        //  :     
+        auto fail = [&](uint64_t failed) {
+            reset();
+            pipe.failed_generation.store(failed, std::memory_order_release);
+        };
+
+        //          ,    load_all_students:
+        //   snapshot_urls,   .    -  
+        auto merged_students = [&]() -> Listing {
+            if (source_count == 1) {
+                return listings.front();
+            }
+            std::vector<const std::vector<domain::Student>*> parts;
+            for (const auto& listing : listings) {
+                parts.push_back(listing.get());
+            }
+            return std::make_shared<const std::vector<domain::Student>>(data_loader::merge_listings(parts));
+        };
+
+        //        ;  -     
+        while (auto message = pipe.messages.wait_pop()) {
+            //          
+            if (message->generation != pipe.generation.load(std::memory_order_acquire) ||
+                pipe.failed_generation.load(std::memory_order_acquire) == message->generation) {
+                pipe.stale_dropped.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            pipe.queue_latency.record(std::chrono::steady_clock::now() - message->received);
+            if (message->generation != generation) {
+                generation = message->generation;
+                reset();
+            }
+            SnapshotStream& stream = incoming[message->source];
+
+            try {
+                switch (message->kind) {
+                case wire::MessageKind::SnapshotBegin:
+                    stream = SnapshotStream{};
+                    break;
+
+                case wire::MessageKind::Snapshot: {
+                    //   ,      
+                    const auto start = std::chrono::steady_clock::now();
+                    stream.runs.push_back(wire::decode_students(message->payload.to_string_view(), message->format));
+                    pipe.decode_latency.record(std::chrono::steady_clock::now() - start);
+                    stream.bytes += message->payload.size();
+                    stream.records += stream.runs.back().size();
+                    pipe.records_decoded.fetch_add(stream.runs.back().size(), std::memory_order_relaxed);
+                    break;
+                }
+
+                case wire::MessageKind::SnapshotEnd: {
+                    //   :       
+                    // ;     ,   -  
+                    auto start = std::chrono::steady_clock::now();
+                    auto sorted = std::make_shared<std::vector<domain::Student>>();
+                    sorted->reserve(stream.records);
+                    util::merge_sorted_runs(std::move(stream.runs), domain::Student::order{},
+                        [&](domain::Student&& student) { sorted->push_back(std::move(student)); });
+                    pipe.sort_latency.record(std::chrono::steady_clock::now() - start);
+                    snapshot_bytes += stream.bytes;
+                    stream = SnapshotStream{};
+                    listings[message->source] = std::move(sorted);
+                    pending[message->source].clear();
+
+                    //  ,     
+                    if (++sources_ready < source_count) {
+                        break;
+                    }
+
+                    RenderFrame frame;
+                    frame.caption = "\nReceived new data batch (" + std::to_string(snapshot_bytes) + " bytes).";
+                    start = std::chrono::steady_clock::now();
+                    frame.students = merged_students();
+                    if (source_count > 1) {
+                        pipe.sort_latency.record(std::chrono::steady_clock::now() - start);
+                    }
+                    if (pipe.render.publish(std::move(frame))) {
+                        pipe.renders_conflated.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    break;
+                }
+
+                case wire::MessageKind::Delta: {
+                    const auto decode_start = std::chrono::steady_clock::now();
+                    data_loader::StudentDelta delta;
+                    delta.added = wire::decode_students(message->payload.to_string_view(), message->format);
+                    delta.removed = wire::decode_students(message->removed.to_string_view(), message->format);
+                    pipe.decode_latency.record(std::chrono::steady_clock::now() - decode_start);
+                    pipe.records_decoded.fetch_add(delta.added.size() + delta.removed.size(), std::memory_order_relaxed);
+                    data_loader::accumulate_delta(pending[message->source], delta);
+
+                    //           ,
+                    //      
+                    if (!pipe.messages.empty() || sources_ready < source_count) {
+                        pipe.states_skipped.fetch_add(1, std::memory_order_relaxed);
+                        break;
+                    }
+
+                    //         
+                    RenderFrame frame;
+                    frame.caption = "\nApplied delta #" + std::to_string(message->sequence) + " for topic " + message->topic +
+                        " (+" + std::to_string(delta.added.size()) + " / -" + std::to_string(delta.removed.size()) + ").";
+                    const auto sort_start = std::chrono::steady_clock::now();
+                    for (size_t i = 0; i < source_count; ++i) {
+                        if (!pending[i].empty()) {
+                            listings[i] = std::make_shared<const std::vector<domain::Student>>(
+                                data_loader::apply_changes(*listings[i], pending[i]));
+                            pending[i].clear();
+                        }
+                    }
+                    frame.students = merged_students();
+                    pipe.sort_latency.record(std::chrono::steady_clock::now() - sort_start);
+                    if (pipe.render.publish(std::move(frame))) {
+                        pipe.renders_conflated.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    break;
+                }
+
+                default:
+                    break;
+                }
+            }
+            catch (const std::exception& e) {
+                std::cerr << "Deserialization Error (" << wire::format_name(message->format) << "): " << e.what() << std::endl;
+                pipe.rejected_messages.fetch_add(1, std::memory_order_relaxed);
+                fail(message->generation);
+            }
+        }
+        pipe.render.close();
     }
 
-    void Server::displayStudents(const std::vector<domain::Student>& students) const {
-        std::cout << "\n=======================================================" << std::endl;
-        std::cout << "       Sorted Student List (Total: " << students.size() << ")" << std::endl;
-        std::cout << "=======================================================" << std::endl;
+    void Server::renderLoop(std::atomic<bool>& running_flag) {
+        ClientPipeline& pipe = *pipeline;
 
-        for (size_t i = 0; i < students.size(); ++i) {
-            std::stringstream ss;
-            ss << std::format("{:%d.%m.%Y}", students[i].birth_date);
+        std::unique_ptr<render::ListingWriter> writer;
+        try {
+            writer = std::make_unique<render::ListingWriter>(options.output_path, options.output_format);
+        }
+        catch (const std::exception& e) {
+            //   ,   
+            std::cerr << "Output Error: " << e.what() << std::endl;
+        }
 
-            std::cout << std::left
-                << std::setw(3) << (i + 1) << ". "
-                << std::setw(30) << students[i].fio
-                << " | "
-                << std::setw(10) << ss.str()
-                << " (ID: " << students[i].id << ")"
-                << std::endl;
+        while (auto frame = pipe.render.wait_take()) {
+            std::cout << frame->caption << std::endl;
+            if (writer) {
+                try {
+                    const auto start = std::chrono::steady_clock::now();
+                    writer->write(*frame->students);
+                    pipe.render_latency.record(std::chrono::steady_clock::now() - start);
+                }
+                catch (const std::exception& e) {
+                    std::cerr << "Output Error: " << e.what() << std::endl;
+                }
+            }
+            pipe.renders.fetch_add(1, std::memory_order_relaxed);
+            //       ,   Ctrl+C
+            if (options.exit_after_listing) {
+                running_flag = false;
+                break;
+            }
+        }
+        reportPipeline();
+        if (!options.metrics_file.empty()) {
+            metrics::write_metrics_file(options.metrics_file, clientMetricsJson());
         }
-        std::cout << "=======================================================" << std::endl;
     }
-}
\ No newline at end of file
+
+    void Server::proxyLoop(std::atomic<bool>& running_flag) {
+        try {
+            //    PUB  XSUB,  - SUB  XPUB.  
+            //  ,   -    .
+            //     :       
+            zmq::socket_t frontend(zmq_context, zmq::socket_type::xsub);
+            frontend.bind(options.upstream_url);
+            zmq::socket_t backend(zmq_context, zmq::socket_type::xpub);
+            backend.set(zmq::sockopt::sndhwm, options.sndhwm);
+            backend.bind(options.url);
+            std::cout << "ZMQ proxy: XSUB bound to " << options.upstream_url << ", XPUB bound to " << options.url << std::endl;
+
+            //   kProxyBatch ,  ;   
+            auto forward = [](zmq::socket_t& from, zmq::socket_t& to, size_t& bytes) {
+                size_t count = 0;
+                for (; count < kProxyBatch; ++count) {
+                    std::vector<zmq::message_t> frames;
+                    if (!zmq::recv_multipart(from, std::back_inserter(frames), zmq::recv_flags::dontwait)) {
+                        break;
+                    }
+                    for (const auto& frame : frames) {
+                        bytes += frame.size();
+                    }
+                    zmq::send_multipart(to, frames);
+                }
+                return count;
+            };
+
+            auto next_metrics = std::chrono::steady_clock::now();
+            while (running_flag) {
+                if (!options.metrics_file.empty() && std::chrono::steady_clock::now() >= next_metrics) {
+                    metrics::write_metrics_file(options.metrics_file, proxyMetricsJson());
+                    next_metrics = std::chrono::steady_clock::now() + std::chrono::seconds(options.metrics_interval);
+                }
+
+                zmq::pollitem_t items[] = {
+                    { frontend.handle(), 0, ZMQ_POLLIN, 0 },
+                    { backend.handle(), 0, ZMQ_POLLIN, 0 },
+                };
+                zmq::poll(items, 2, kPollTimeout);
+
+                if (items[0].revents & ZMQ_POLLIN) {
+                    size_t bytes = 0;
+                    const size_t count = forward(frontend, backend, bytes);
+                    server_metrics.proxied_messages.fetch_add(count, std::memory_order_relaxed);
+                    server_metrics.proxied_bytes.fetch_add(bytes, std::memory_order_relaxed);
+                }
+                if (items[1].revents & ZMQ_POLLIN) {
+                    //     
+                    size_t bytes = 0;
+                    const size_t count = forward(backend, frontend, bytes);
+                    server_metrics.subscriptions_forwarded.fetch_add(count, std::memory_order_relaxed);
+                }
+            }
+        }
+        catch (const zmq::error_t& e) {
+            std::cerr << "ZMQ Error (Proxy): " << e.what() << std::endl;
+        }
+        catch (const std::exception& e) {
+            std::cerr << "Standard Exception (Proxy): " << e.what() << std::endl;
+        }
+        if (!options.metrics_file.empty()) {
+            metrics::write_metrics_file(options.metrics_file, proxyMetricsJson());
+        }
+    }
+
+    void Server::reportPipeline() const {
+        const ClientPipeline& pipe = *pipeline;
+        std::cerr << "Pipeline: queue depth " << pipe.messages.size() << "/" << pipe.messages.capacity()
+            << " (max " << pipe.max_depth.load(std::memory_order_relaxed) << ")"
+            << ", received " << pipe.received.load(std::memory_order_relaxed)
+            << ", backpressure waits " << pipe.backpressure_waits.load(std::memory_order_relaxed)
+            << ", stale dropped " << pipe.stale_dropped.load(std::memory_order_relaxed)
+            << ", states skipped " << pipe.states_skipped.load(std::memory_order_relaxed)
+            << ", rendered " << pipe.renders.load(std::memory_order_relaxed)
+            << ", renders conflated " << pipe.renders_conflated.load(std::memory_order_relaxed)
+            << ", unknown source dropped " << pipe.unknown_source_dropped.load(std::memory_order_relaxed)
+            << std::endl;
+    }
+
+    nlohmann::json Server::serverMetricsJson() const {
+        const ServerMetrics& m = server_metrics;
+        nlohmann::json rejected_by_reason = nlohmann::json::object();
+        for (size_t i = 0; i < data_loader::kRejectReasonCount; ++i) {
+            rejected_by_reason[std::string(data_loader::reject_reason_name(static_cast<data_loader::RejectReason>(i)))] =
+                m.rejected_by_reason[i].load(std::memory_order_relaxed);
+        }
+        return {
+            { "role", "server" },
+            { "timestamp_us", metrics::now_us() },
+            { "counters", {
+                { "loads", m.loads.load(std::memory_order_relaxed) },
+                { "last_load_lines", m.lines.load(std::memory_order_relaxed) },
+                { "last_load_rejected_lines", m.rejected_lines.load(std::memory_order_relaxed) },
+                { "last_load_rejected_by_reason", rejected_by_reason },
+                { "reject_log_dropped", reject_log ? reject_log->dropped() : 0 },
+                { "records", m.records.load(std::memory_order_relaxed) },
+                { "deltas_published", m.deltas_published.load(std::memory_order_relaxed) },
+                { "heartbeats_published", m.heartbeats_published.load(std::memory_order_relaxed) },
+                { "bytes_published", m.bytes_published.load(std::memory_order_relaxed) },
+                { "snapshots_served", m.snapshots_served.load(std::memory_order_relaxed) },
+                { "snapshot_chunks", m.snapshot_chunks.load(std::memory_order_relaxed) },
+                { "snapshot_bytes", m.snapshot_bytes.load(std::memory_order_relaxed) },
+            } },
+            { "latency_us", {
+                { "load", m.load_latency.to_json() },
+                { "encode", m.encode_latency.to_json() },
+                { "snapshot_send", m.snapshot_latency.to_json() },
+            } },
+        };
+    }
+
+    nlohmann::json Server::clientMetricsJson() const {
+        const ClientPipeline& pipe = *pipeline;
+        return {
+            { "role", "client" },
+            { "timestamp_us", metrics::now_us() },
+            { "counters", {
+                { "messages_received", pipe.received.load(std::memory_order_relaxed) },
+                { "bytes_received", pipe.bytes_received.load(std::memory_order_relaxed) },
+                { "records_decoded", pipe.records_decoded.load(std::memory_order_relaxed) },
+                { "rejected_messages", pipe.rejected_messages.load(std::memory_order_relaxed) },
+                { "unknown_source_dropped", pipe.unknown_source_dropped.load(std::memory_order_relaxed) },
+                { "backpressure_waits", pipe.backpressure_waits.load(std::memory_order_relaxed) },
+                { "stale_dropped", pipe.stale_dropped.load(std::memory_order_relaxed) },
+                { "states_skipped", pipe.states_skipped.load(std::memory_order_relaxed) },
+                { "renders", pipe.renders.load(std::memory_order_relaxed) },
+                { "renders_conflated", pipe.renders_conflated.load(std::memory_order_relaxed) },
+            } },
+            { "queue", {
+                { "depth", pipe.messages.size() },
+                { "max_depth", pipe.max_depth.load(std::memory_order_relaxed) },
+                { "capacity", pipe.messages.capacity() },
+            } },
+            { "latency_us", {
+                { "publish_to_receive", pipe.publish_latency.to_json() },
+                { "queue_wait", pipe.queue_latency.to_json() },
+                { "decode", pipe.decode_latency.to_json() },
+                { "sort", pipe.sort_latency.to_json() },
+                { "render", pipe.render_latency.to_json() },
+            } },
+        };
+    }
+
+    nlohmann::json Server::proxyMetricsJson() const {
+        const ServerMetrics& m = server_metrics;
+        return {
+            { "role", "proxy" },
+            { "timestamp_us", metrics::now_us() },
+            { "counters", {
+                { "messages_forwarded", m.proxied_messages.load(std::memory_order_relaxed) },
+                { "bytes_forwarded", m.proxied_bytes.load(std::memory_order_relaxed) },
+                { "subscriptions_forwarded", m.subscriptions_forwarded.load(std::memory_order_relaxed) },
+            } },
+        };
+    }
+}
@@ -1,19 +1,69 @@
 ﻿#pragma once
 #include <thread>
 #include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
 #include <zmq.hpp>
 
 
 #include "student.hpp"
 #include "data_loader.hpp"
+#include "external_sort.hpp"
+#include "wire_format.hpp"
+#include "spsc_queue.hpp"
+#include "listing_writer.hpp"
+#include "metrics.hpp"
 
 namespace server {
-	enum  TypeMode { Listener, Publisher };
+	enum  TypeMode { Listener, Publisher, Proxy };
 
 	struct Options {
 		TypeMode typeMode;
 		std::string url;
 		std::optional<std::string> dir;
+		// Сокеты ROUTER, по которым клиенты запрашивают полный снимок. Сервер привязывает первый;
+		// клиент за прокси запрашивает снимок у каждого сервера и объединяет их записи
+		// (при совпадении ФИО и даты рождения побеждает сервер, указанный раньше)
+		std::vector<std::string> snapshot_urls{ "tcp://127.0.0.1:5556" };
+		// Темы (первые буквы ФИО), на которые подписывается клиент; пусто - все
+		std::vector<std::string> topics;
+		// Число записей в одном фрагменте снимка
+		std::size_t chunk_size = 10000;
+		std::size_t loader_threads = 1;
+		// Бинарный кэш разобранных файлов для быстрого повторного запуска (включается явно:
+		// файлы, разобранные заново, делятся между потоками по файлу, без разбиения на сегменты);
+		// пустой cache_path - файл во временном каталоге, см. data_loader::default_cache_path
+		bool use_cache = false;
+		std::string cache_path;
+		// Файл CSV с отбракованными строками (file,line,reason,text); пусто - сообщения в std::cerr.
+		// Запись асинхронная, в конце каждой загрузки выводится сводка по причинам
+		std::string reject_file;
+		// Бюджет памяти загрузки, МиБ: файлы разбираются в отсортированные прогоны на диске и объединяются
+		// потоковым слиянием. Набор остаётся в файле, фрагменты снимка кодируются из него при каждом запросе.
+		// 0 - весь набор в памяти.
+		// Кэш разобранных файлов в этом режиме не используется
+		std::size_t memory_budget = 0;
+		// Каталог временных файлов такой загрузки; пусто - системный временный каталог
+		std::string spill_dir;
+		wire::Format format = wire::Format::Binary;
+		// Ёмкость очереди между потоком приёма и потоком декодирования клиента
+		std::size_t queue_capacity = 4096;
+		// Куда клиент выводит отсортированный список: пусто - консоль, иначе файл или канал
+		std::string output_path;
+		render::OutputFormat output_format = render::OutputFormat::Text;
+		// Клиент завершает работу после вывода первого списка (проверки и скрипты)
+		bool exit_after_listing = false;
+		// Файл метрик (JSON), периодически перезаписываемый целиком; пусто - не писать
+		std::string metrics_file;
+		std::size_t metrics_interval = 5;   // секунды
+		// Период heartbeat-сообщений сервера при отсутствии изменений
+		std::size_t publish_interval_ms = 5000;
+		// Лимит очереди отправки PUB-сокета (ZMQ_SNDHWM), 0 - без ограничения
+		int sndhwm = 1000;
+		// XSUB-сокет прокси: прокси его привязывает, сервер подключает к нему свой PUB вместо привязки url
+		std::string upstream_url;
 	};
 
     class Server {
@@ -26,30 +76,168 @@ namespace server {
             if (options.typeMode == TypeMode::Listener) {
                 // Сервер/Publisher: Чтение файлов и отправка данных
                 listenerThread = std::thread(&Server::serverLoop, this, std::ref(running_flag));
+                // Ответы на запросы полного снимка
+                snapshotThread = std::thread(&Server::snapshotLoop, this, std::ref(running_flag));
             }
             else if (options.typeMode == TypeMode::Publisher) {
-                // Клиент/Subscriber: Получение данных, сортировка и вывод
+                // Клиент/Subscriber: конвейер приём -> декодирование и сортировка -> вывод
+                pipeline = std::make_unique<ClientPipeline>(options.queue_capacity);
                 publisherThread = std::thread(&Server::clientLoop, this, std::ref(running_flag));
+                decodeThread = std::thread(&Server::decodeLoop, this);
+                renderThread = std::thread(&Server::renderLoop, this, std::ref(running_flag));
+            }
+            else if (options.typeMode == TypeMode::Proxy) {
+                // Прокси: пересылка сообщений нескольких серверов клиентам
+                proxyThread = std::thread(&Server::proxyLoop, this, std::ref(running_flag));
             }
 
             // Основной поток блокируется, чтобы приложение не завершилось,
             // пока работают рабочие потоки.
             if (listenerThread.joinable()) listenerThread.join();
             if (publisherThread.joinable()) publisherThread.join();
+            if (decodeThread.joinable()) decodeThread.join();
+            if (renderThread.joinable()) renderThread.join();
+            if (snapshotThread.joinable()) snapshotThread.join();
+            if (proxyThread.joinable()) proxyThread.join();
         }
 
         void stop() { running = false; }
 
     private:
+        // Закодированные записи темы (отсортированные фрагменты по chunk_size записей)
+        // и номер последнего учтённого в них изменения
+        struct TopicSnapshot {
+            uint64_t sequence = 0;
+            std::vector<std::string> chunks;
+        };
+
+        // В режиме с бюджетом памяти фрагменты не хранятся: у тем только номера, а фрагменты кодируются
+        // из отсортированного файла file при каждом запросе
+        struct Snapshot {
+            std::map<std::string, std::shared_ptr<const TopicSnapshot>> topics;
+            std::shared_ptr<const data_loader::SortedRunFile> file;
+        };
+
+        // Сообщение, переданное потоком приёма потоку декодирования.
+        // generation - номер запроса снимка, после которого сообщение получено,
+        // source - номер сервера в списке snapshot_urls
+        struct ClientMessage {
+            wire::MessageKind kind = wire::MessageKind::Heartbeat;
+            uint64_t generation = 0;
+            std::string topic{};
+            uint64_t sequence = 0;
+            wire::Format format = wire::Format::Binary;
+            zmq::message_t payload{};
+            zmq::message_t removed{};
+            std::chrono::steady_clock::time_point received{};
+            std::size_t source = 0;
+        };
+
+        // Отсортированный список, готовый к выводу; список общий с потоком декодирования и не копируется
+        struct RenderFrame {
+            std::string caption;
+            std::shared_ptr<const std::vector<domain::Student>> students;
+        };
+
+        // Очереди и счётчики клиентского конвейера
+        struct ClientPipeline {
+            explicit ClientPipeline(std::size_t capacity) : messages(capacity) {}
+
+            util::SpscQueue<ClientMessage> messages;
+            // Новый список вытесняет ещё не выведенный (конфляция)
+            util::LatestValue<RenderFrame> render;
+
+            // Текущий номер запроса снимка: сообщения предыдущих запросов устарели
+            std::atomic<uint64_t> generation{ 0 };
+            // Номер запроса, данные которого не удалось декодировать
+            std::atomic<uint64_t> failed_generation{ 0 };
+
+            std::atomic<uint64_t> received{ 0 };
+            std::atomic<uint64_t> backpressure_waits{ 0 };
+            std::atomic<uint64_t> max_depth{ 0 };
+            std::atomic<uint64_t> stale_dropped{ 0 };
+            std::atomic<uint64_t> states_skipped{ 0 };
+            std::atomic<uint64_t> renders{ 0 };
+            std::atomic<uint64_t> renders_conflated{ 0 };
+
+            std::atomic<uint64_t> bytes_received{ 0 };
+            std::atomic<uint64_t> records_decoded{ 0 };
+            std::atomic<uint64_t> rejected_messages{ 0 };
+            // Сообщения серверов, не ответивших на запрос снимка (нет в snapshot_urls)
+            std::atomic<uint64_t> unknown_source_dropped{ 0 };
+
+            // Задержки в микросекундах: публикация -> приём (по часам сервера и клиента),
+            // ожидание в очереди, декодирование, слияние/сортировка, вывод
+            metrics::LatencyHistogram publish_latency;
+            metrics::LatencyHistogram queue_latency;
+            metrics::LatencyHistogram decode_latency;
+            metrics::LatencyHistogram sort_latency;
+            metrics::LatencyHistogram render_latency;
+        };
+
+        // Счётчики сервера (пишутся потоками публикации и снимков) и прокси
+        struct ServerMetrics {
+            std::atomic<uint64_t> loads{ 0 };
+            std::atomic<uint64_t> lines{ 0 };
+            std::atomic<uint64_t> rejected_lines{ 0 };
+            std::array<std::atomic<uint64_t>, data_loader::kRejectReasonCount> rejected_by_reason{};
+            std::atomic<uint64_t> records{ 0 };
+            std::atomic<uint64_t> deltas_published{ 0 };
+            std::atomic<uint64_t> heartbeats_published{ 0 };
+            std::atomic<uint64_t> bytes_published{ 0 };
+            std::atomic<uint64_t> snapshots_served{ 0 };
+            std::atomic<uint64_t> snapshot_chunks{ 0 };
+            std::atomic<uint64_t> snapshot_bytes{ 0 };
+            std::atomic<uint64_t> proxied_messages{ 0 };
+            std::atomic<uint64_t> proxied_bytes{ 0 };
+            std::atomic<uint64_t> subscriptions_forwarded{ 0 };
+
+            // Загрузка каталога, кодирование снимка, отправка снимка клиенту (микросекунды)
+            metrics::LatencyHistogram load_latency;
+            metrics::LatencyHistogram encode_latency;
+            metrics::LatencyHistogram snapshot_latency;
+        };
+
         Options options;
+        // Идентификатор экземпляра сервера в заголовках сообщений, новый при каждом запуске
+        const uint64_t source_id = makeSourceId();
         std::atomic<bool> running;
         zmq::context_t zmq_context;
 
         std::thread listenerThread;
         std::thread publisherThread;
+        std::thread snapshotThread;
+        std::thread decodeThread;
+        std::thread renderThread;
+        std::thread proxyThread;
+
+        std::unique_ptr<ClientPipeline> pipeline;
+        ServerMetrics server_metrics;
+        std::unique_ptr<data_loader::RejectLog> reject_log;
+
+        std::mutex snapshot_mutex;
+        std::condition_variable snapshot_ready;
+        std::shared_ptr<const Snapshot> snapshot;
 
         void serverLoop(std::atomic<bool>& running_flag);
+        void snapshotLoop(std::atomic<bool>& running_flag);
         void clientLoop(std::atomic<bool>& running_flag);
-        void displayStudents(const std::vector<domain::Student>& students) const;
+        void decodeLoop();
+        void renderLoop(std::atomic<bool>& running_flag);
+        void proxyLoop(std::atomic<bool>& running_flag);
+        void reportPipeline() const;
+        nlohmann::json serverMetricsJson() const;
+        nlohmann::json clientMetricsJson() const;
+        nlohmann::json proxyMetricsJson() const;
+        static uint64_t makeSourceId();
+        data_loader::StudentSet loadStudents();
+        data_loader::SortedRunFile loadStudentsExternal();
+        void recordLoad(const data_loader::LoadStats& stats, size_t records, std::chrono::steady_clock::time_point start);
+        void updateSnapshot(const std::map<std::string, data_loader::StudentSet>& topic_sets,
+            const std::map<std::string, uint64_t>& topic_sequences, const std::vector<std::string>& changed_topics);
+        void updateSnapshot(std::shared_ptr<const data_loader::SortedRunFile> students,
+            const std::map<std::string, uint64_t>& topic_sequences);
+        void storeSnapshot(std::shared_ptr<const Snapshot> next);
+        std::shared_ptr<const Snapshot> currentSnapshot();
     };
 }
\ No newline at end of file
@@ -0,0 +1,278 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace util
+{
+    // Размер линии кэша; индексы производителя и потребителя разнесены по разным линиям
+    inline constexpr std::size_t kCacheLine = 64;
+
+    // Пробуждение потребителя без опроса: счётчик событий, которого ждёт std::atomic::wait.
+    // Потребитель берёт epoch() до проверки данных и засыпает на нём, только если после этого
+    // не было notify(); notify() без ждущих потоков не делает системного вызова
+    class WakeSignal
+    {
+    public:
+        std::uint32_t epoch() const { return value_.load(std::memory_order_acquire); }
+        void wait(std::uint32_t epoch) const { value_.wait(epoch, std::memory_order_acquire); }
+
+        void notify() {
+            value_.fetch_add(1, std::memory_order_release);
+            value_.notify_one();
+        }
+
+    private:
+        std::atomic<std::uint32_t> value_{ 0 };
+    };
+
+    // Ограниченная очередь без блокировок: один поток-производитель, один поток-потребитель.
+    // Ёмкость округляется вверх до степени двойки
+    template <typename T>
+    class SpscQueue
+    {
+    public:
+        explicit SpscQueue(std::size_t capacity)
+            : slots_(std::bit_ceil(std::max<std::size_t>(capacity, 2))), mask_(slots_.size() - 1) {
+        }
+
+        SpscQueue(const SpscQueue&) = delete;
+        SpscQueue& operator=(const SpscQueue&) = delete;
+
+        // false, если очередь заполнена; value в этом случае не перемещается
+        bool try_push(T&& value) {
+            const std::size_t tail = tail_.load(std::memory_order_relaxed);
+            if (tail - head_cache_ == slots_.size()) {
+                head_cache_ = head_.load(std::memory_order_acquire);
+                if (tail - head_cache_ == slots_.size()) {
+                    return false;
+                }
+            }
+            slots_[tail & mask_] = std::move(value);
+            tail_.store(tail + 1, std::memory_order_release);
+            signal_.notify();
+            return true;
+        }
+
+        // Производитель: значений больше не будет; ждущий потребитель просыпается
+        void close() {
+            closed_.store(true, std::memory_order_release);
+            signal_.notify();
+        }
+
+        // Потребитель: ждёт значения, не опрашивая очередь; nullopt - очередь закрыта и пуста
+        std::optional<T> wait_pop() {
+            for (;;) {
+                const std::uint32_t epoch = signal_.epoch();
+                if (auto value = try_pop()) {
+                    return value;
+                }
+                if (closed_.load(std::memory_order_acquire)) {
+                    return try_pop();
+                }
+                signal_.wait(epoch);
+            }
+        }
+
+        std::optional<T> try_pop() {
+            const std::size_t head = head_.load(std::memory_order_relaxed);
+            if (head == tail_cache_) {
+                tail_cache_ = tail_.load(std::memory_order_acquire);
+                if (head == tail_cache_) {
+                    return std::nullopt;
+                }
+            }
+            std::optional<T> value(std::move(slots_[head & mask_]));
+            slots_[head & mask_] = T{};
+            head_.store(head + 1, std::memory_order_release);
+            return value;
+        }
+
+        // Приблизительная глубина очереди; допускается вызов из любого потока
+        std::size_t size() const {
+            return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+        }
+
+        bool empty() const { return size() == 0; }
+        std::size_t capacity() const { return slots_.size(); }
+
+    private:
+        std::vector<T> slots_;
+        const std::size_t mask_;
+
+        alignas(kCacheLine) std::atomic<std::size_t> head_{ 0 };
+        std::size_t tail_cache_ = 0;     // последний увиденный потребителем tail_
+
+        alignas(kCacheLine) std::atomic<std::size_t> tail_{ 0 };
+        std::size_t head_cache_ = 0;     // последний увиденный производителем head_
+
+        alignas(kCacheLine) WakeSignal signal_;
+        std::atomic<bool> closed_{ false };
+    };
+
+    // Ограниченная очередь без блокировок: несколько производителей, один потребитель.
+    // Каждая ячейка хранит номер, по которому производитель узнаёт, что ячейка свободна,
+    // а потребитель - что значение записано (кольцевой буфер Вьюкова).
+    // Ёмкость округляется вверх до степени двойки
+    template <typename T>
+    class MpscQueue
+    {
+    public:
+        explicit MpscQueue(std::size_t capacity)
+            : cells_(std::bit_ceil(std::max<std::size_t>(capacity, 2))), mask_(cells_.size() - 1) {
+            for (std::size_t i = 0; i < cells_.size(); ++i) {
+                cells_[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        MpscQueue(const MpscQueue&) = delete;
+        MpscQueue& operator=(const MpscQueue&) = delete;
+
+        // false, если очередь заполнена; value в этом случае не перемещается
+        bool try_push(T&& value) {
+            std::size_t tail = tail_.load(std::memory_order_relaxed);
+            Cell* cell;
+            for (;;) {
+                cell = &cells_[tail & mask_];
+                const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                const auto diff = static_cast<std::ptrdiff_t>(sequence - tail);
+                if (diff == 0) {
+                    if (tail_.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                }
+                else if (diff < 0) {
+                    return false;
+                }
+                else {
+                    tail = tail_.load(std::memory_order_relaxed);
+                }
+            }
+            cell->value = std::move(value);
+            cell->sequence.store(tail + 1, std::memory_order_release);
+            signal_.notify();
+            return true;
+        }
+
+        // Значений больше не будет (все производители закончили); ждущий потребитель просыпается
+        void close() {
+            closed_.store(true, std::memory_order_release);
+            signal_.notify();
+        }
+
+        // Только из потока-потребителя: ждёт значения без опроса; nullopt - очередь закрыта и пуста
+        std::optional<T> wait_pop() {
+            for (;;) {
+                const std::uint32_t epoch = signal_.epoch();
+                if (auto value = try_pop()) {
+                    return value;
+                }
+                if (closed_.load(std::memory_order_acquire)) {
+                    return try_pop();
+                }
+                signal_.wait(epoch);
+            }
+        }
+
+        // Только из потока-потребителя
+        std::optional<T> try_pop() {
+            const std::size_t head = head_.load(std::memory_order_relaxed);
+            Cell& cell = cells_[head & mask_];
+            if (cell.sequence.load(std::memory_order_acquire) != head + 1) {
+                return std::nullopt;
+            }
+            std::optional<T> value(std::move(cell.value));
+            cell.value = T{};
+            cell.sequence.store(head + cells_.size(), std::memory_order_release);
+            head_.store(head + 1, std::memory_order_release);
+            return value;
+        }
+
+        // Приблизительная глубина очереди; допускается вызов из любого потока
+        std::size_t size() const {
+            const std::size_t head = head_.load(std::memory_order_acquire);
+            const std::size_t tail = tail_.load(std::memory_order_acquire);
+            return tail > head ? tail - head : 0;
+        }
+
+        bool empty() const { return size() == 0; }
+        std::size_t capacity() const { return cells_.size(); }
+
+    private:
+        struct Cell {
+            std::atomic<std::size_t> sequence{ 0 };
+            T value{};
+        };
+
+        std::vector<Cell> cells_;
+        const std::size_t mask_;
+
+        alignas(kCacheLine) std::atomic<std::size_t> head_{ 0 };
+        alignas(kCacheLine) std::atomic<std::size_t> tail_{ 0 };
+        alignas(kCacheLine) WakeSignal signal_;
+        std::atomic<bool> closed_{ false };
+    };
+
+    // Ячейка "последнее значение" без блокировок: новое значение вытесняет ещё не забранное старое.
+    // Используется для конфляции, когда потребителю нужна только самая свежая версия
+    template <typename T>
+    class LatestValue
+    {
+    public:
+        LatestValue() = default;
+        LatestValue(const LatestValue&) = delete;
+        LatestValue& operator=(const LatestValue&) = delete;
+
+        ~LatestValue() {
+            delete slot_.load(std::memory_order_acquire);
+        }
+
+        // true, если при этом было вытеснено незабранное значение
+        bool publish(T value) {
+            T* previous = slot_.exchange(new T(std::move(value)), std::memory_order_acq_rel);
+            signal_.notify();
+            if (previous == nullptr) {
+                return false;
+            }
+            delete previous;
+            return true;
+        }
+
+        // Новых значений больше не будет; ждущий потребитель просыпается
+        void close() {
+            closed_.store(true, std::memory_order_release);
+            signal_.notify();
+        }
+
+        std::unique_ptr<T> take() {
+            return std::unique_ptr<T>(slot_.exchange(nullptr, std::memory_order_acq_rel));
+        }
+
+        // Ждёт значения без опроса; nullptr - ячейка закрыта и пуста. Один поток-потребитель
+        std::unique_ptr<T> wait_take() {
+            for (;;) {
+                const std::uint32_t epoch = signal_.epoch();
+                if (auto value = take()) {
+                    return value;
+                }
+                if (closed_.load(std::memory_order_acquire)) {
+                    return take();
+                }
+                signal_.wait(epoch);
+            }
+        }
+
+        bool has_value() const { return slot_.load(std::memory_order_acquire) != nullptr; }
+
+    private:
+        std::atomic<T*> slot_{ nullptr };
+        WakeSignal signal_;
+        std::atomic<bool> closed_{ false };
+    };
+}
@@ -1,11 +1,51 @@
 #pragma once
 #include <string>
+#include <string_view>
 #include <chrono>
+#include <cstdint>
+#include <cstring>
 #include <format>
 #include <nlohmann/json.hpp>
 
 namespace domain {
 
+	//       1970-01-01
+	inline int32_t to_days(std::chrono::year_month_day date) {
+		return static_cast<int32_t>(std::chrono::sys_days{ date }.time_since_epoch().count());
+	}
+
+	inline std::chrono::year_month_day from_days(int32_t days) {
+		return std::chrono::year_month_day{ std::chrono::sys_days{ std::chrono::days{ days } } };
+	}
+
+	//  splitmix64:       
+	inline uint64_t mix64(uint64_t x) {
+		x ^= x >> 30;
+		x *= 0xbf58476d1ce4e5b9ull;
+		x ^= x >> 27;
+		x *= 0x94d049bb133111ebull;
+		x ^= x >> 31;
+		return x;
+	}
+
+	//    +  .     8 
+	inline uint64_t key_hash(std::string_view fio, int32_t days) {
+		uint64_t h = 0x9E3779B97F4A7C15ull ^ fio.size();
+		size_t i = 0;
+		for (; i + 8 <= fio.size(); i += 8) {
+			uint64_t word;
+			std::memcpy(&word, fio.data() + i, 8);
+			h = (h ^ word) * 0xff51afd7ed558ccdull;
+			h ^= h >> 32;
+		}
+		uint64_t tail = 0;
+		if (i < fio.size()) {
+			std::memcpy(&tail, fio.data() + i, fio.size() - i);
+		}
+		h = (h ^ tail) * 0xff51afd7ed558ccdull;
+		return mix64(h ^ (static_cast<uint64_t>(static_cast<uint32_t>(days)) << 1));
+	}
+
 	struct Student
 	{
 		uint16_t id{};
@@ -20,14 +60,19 @@ namespace domain {
 			return fio < other.fio;
 		}
 
+		//      :  ,    
+		struct order {
+			bool operator()(const domain::Student& a, const domain::Student& b) const {
+				if (a.fio != b.fio) {
+					return a.fio < b.fio;
+				}
+				return a.birth_date < b.birth_date;
+			}
+		};
+
 		struct hash {
 			size_t operator()(const domain::Student& s) const {
-				size_t h1 = std::hash<std::string>{}(s.fio);
-				size_t h2 = std::hash<int>{}(static_cast<int>(s.birth_date.year()));
-				size_t h3 = std::hash<unsigned int>{}(static_cast<unsigned int>(s.birth_date.month()));
-				size_t h4 = std::hash<unsigned int>{}(static_cast<unsigned int>(s.birth_date.day()));
-
-				return h1 ^ (h2 << 1) ^ (h3 << 2) ^ (h4 << 3);
+				return static_cast<size_t>(key_hash(s.fio, to_days(s.birth_date)));
 			}
 		};
 	};
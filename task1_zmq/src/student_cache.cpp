@@ -0,0 +1,152 @@
+#include "student_cache.hpp"
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+
+namespace data_loader
+{
+    namespace {
+        // Формат (little-endian):
+        //   "STUC", u8 версия, u16 длина пути каталога, путь каталога, u32 число файлов;
+        //   для каждого файла: u16 длина имени, имя, u64 размер, i64 время изменения,
+        //   u64 строк, u64 отбраковано, u64 отбраковано по каждой причине (kRejectReasonCount),
+        //   u64 длина нагрузки, нагрузка.
+        // Каталог - канонический путь каталога с данными: кэш, указанный через --cache-file,
+        // не применяется к файлам с теми же именами в другом каталоге.
+        // Версия повышается при изменении формата или правил разбора строк
+        constexpr std::string_view kMagic = "STUC";
+        constexpr uint8_t kVersion = 3;
+        constexpr size_t kEntryFixedSize = 2 + 8 * (5 + kRejectReasonCount);
+
+        void put_u16(std::string& out, uint16_t v) {
+            out.push_back(static_cast<char>(v & 0xFF));
+            out.push_back(static_cast<char>(v >> 8));
+        }
+
+        void put_u32(std::string& out, uint32_t v) {
+            for (int shift = 0; shift < 32; shift += 8) {
+                out.push_back(static_cast<char>((v >> shift) & 0xFF));
+            }
+        }
+
+        void put_u64(std::string& out, uint64_t v) {
+            put_u32(out, static_cast<uint32_t>(v));
+            put_u32(out, static_cast<uint32_t>(v >> 32));
+        }
+
+        // Последовательное чтение с проверкой границ
+        class Reader
+        {
+        public:
+            explicit Reader(std::string_view data) : data_(data) {}
+
+            std::string_view bytes(size_t n) {
+                if (data_.size() - pos_ < n) {
+                    throw std::runtime_error("Student cache is truncated");
+                }
+                std::string_view result = data_.substr(pos_, n);
+                pos_ += n;
+                return result;
+            }
+
+            uint64_t u(size_t n) {
+                const auto* p = reinterpret_cast<const unsigned char*>(bytes(n).data());
+                uint64_t value = 0;
+                for (size_t i = 0; i < n; ++i) {
+                    value |= static_cast<uint64_t>(p[i]) << (8 * i);
+                }
+                return value;
+            }
+
+            bool done() const { return pos_ == data_.size(); }
+
+        private:
+            std::string_view data_;
+            size_t pos_ = 0;
+        };
+    }
+
+    std::filesystem::path default_cache_path(const std::string& dir_path) {
+        // FNV-1a: имя файла не зависит от реализации std::hash
+        uint64_t hash = 14695981039346656037ull;
+        for (const unsigned char c : std::filesystem::weakly_canonical(dir_path).string()) {
+            hash = (hash ^ c) * 1099511628211ull;
+        }
+        char name[40];
+        std::snprintf(name, sizeof(name), "students-%016llx.cache", static_cast<unsigned long long>(hash));
+        return std::filesystem::temp_directory_path() / name;
+    }
+
+    std::vector<CacheEntry> read_student_cache(std::string_view data, std::string_view directory) {
+        Reader reader(data);
+        if (reader.bytes(kMagic.size()) != kMagic) {
+            throw std::runtime_error("Not a student cache");
+        }
+        if (reader.u(1) != kVersion) {
+            throw std::runtime_error("Unsupported student cache version");
+        }
+        if (reader.bytes(reader.u(2)) != directory) {
+            throw std::runtime_error("Student cache belongs to another directory");
+        }
+        const uint64_t count = reader.u(4);
+        if (count > data.size() / kEntryFixedSize) {
+            throw std::runtime_error("Student cache file count exceeds its size");
+        }
+
+        std::vector<CacheEntry> entries(count);
+        for (auto& entry : entries) {
+            entry.name = reader.bytes(reader.u(2));
+            entry.size = reader.u(8);
+            entry.mtime = static_cast<int64_t>(reader.u(8));
+            entry.stats.lines = reader.u(8);
+            entry.stats.rejected = reader.u(8);
+            for (auto& count : entry.stats.rejected_by_reason) {
+                count = reader.u(8);
+            }
+            entry.payload = reader.bytes(reader.u(8));
+        }
+        if (!reader.done()) {
+            throw std::runtime_error("Unexpected trailing bytes in student cache");
+        }
+        return entries;
+    }
+
+    std::filesystem::path write_student_cache(const std::filesystem::path& path, std::string_view directory,
+        const std::vector<CacheEntry>& entries) {
+        std::filesystem::path tmp_path = path;
+        tmp_path += ".tmp";
+        std::ofstream ofs(tmp_path, std::ios::binary | std::ios::trunc);
+        if (!ofs.is_open()) {
+            throw std::runtime_error("Could not open cache file " + tmp_path.string());
+        }
+
+        std::string header(kMagic);
+        header.push_back(static_cast<char>(kVersion));
+        put_u16(header, static_cast<uint16_t>(directory.size()));
+        header += directory;
+        put_u32(header, static_cast<uint32_t>(entries.size()));
+        ofs.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+        for (const auto& entry : entries) {
+            header.clear();
+            put_u16(header, static_cast<uint16_t>(entry.name.size()));
+            header += entry.name;
+            put_u64(header, entry.size);
+            put_u64(header, static_cast<uint64_t>(entry.mtime));
+            put_u64(header, entry.stats.lines);
+            put_u64(header, entry.stats.rejected);
+            for (const auto count : entry.stats.rejected_by_reason) {
+                put_u64(header, count);
+            }
+            put_u64(header, entry.payload.size());
+            ofs.write(header.data(), static_cast<std::streamsize>(header.size()));
+            ofs.write(entry.payload.data(), static_cast<std::streamsize>(entry.payload.size()));
+        }
+
+        ofs.close();
+        if (!ofs) {
+            throw std::runtime_error("Could not write cache file " + tmp_path.string());
+        }
+        return tmp_path;
+    }
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "data_loader.hpp"
+
+namespace data_loader
+{
+    // Путь кэша по умолчанию: students-<хэш канонического пути каталога>.cache в системном временном
+    // каталоге. Кэш не пишется в каталог с данными: его обновление не будит DirectoryWatcher
+    // и не требует права записи в этот каталог
+    std::filesystem::path default_cache_path(const std::string& dir_path);
+
+    // Разобранный файл *.txt: ключ (имя в каталоге, размер, время изменения), счётчики строк
+    // и записи после объединения дубликатов внутри файла в порядке первого появления
+    // (нагрузка wire::Format::Binary)
+    struct CacheEntry {
+        std::string name;
+        uint64_t size = 0;
+        int64_t mtime = 0;          // file_time_type::duration::count()
+        LoadStats stats;
+        std::string_view payload;
+    };
+
+    // Разбор содержимого файла кэша, записанного для каталога directory; payload указывает внутрь data.
+    // Бросает std::runtime_error при чужой сигнатуре, другой версии, другом каталоге или обрезанных данных
+    std::vector<CacheEntry> read_student_cache(std::string_view data, std::string_view directory);
+
+    // Запись кэша каталога directory во временный файл path + ".tmp", возвращает его путь. Старый кэш
+    // заменяется переименованием после того, как вызывающий освободит его отображение.
+    // Бросает std::runtime_error, если файл не удалось записать
+    std::filesystem::path write_student_cache(const std::filesystem::path& path, std::string_view directory,
+        const std::vector<CacheEntry>& entries);
+}
@@ -0,0 +1,196 @@
+#include "student_store.hpp"
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+namespace data_loader
+{
+    StudentStore::StudentView StudentStore::view(const Record& record) const {
+        return { record.id, fio_of(record), domain::from_days(record.days) };
+    }
+
+    void StudentStore::reserve(size_t count, size_t fio_bytes) {
+        records_.reserve(count);
+        if (fio_bytes > 0) {
+            arena_.reserve(fio_bytes);
+        }
+        // Коэффициент заполнения индекса не превышает 3/4
+        const size_t slot_count = std::bit_ceil(std::max<size_t>(count / 3 * 4 + 4, 16));
+        if (slot_count > slots_.size()) {
+            rehash(slot_count);
+        }
+    }
+
+    void StudentStore::clear() {
+        records_.clear();
+        arena_.clear();
+        std::fill(slots_.begin(), slots_.end(), kEmpty);
+        garbage_bytes_ = 0;
+    }
+
+    size_t StudentStore::find_slot(std::string_view fio, int32_t days, uint32_t hash) const {
+        const size_t mask = slots_.size() - 1;
+        for (size_t i = home_slot(hash); ; i = (i + 1) & mask) {
+            const uint64_t slot = slots_[i];
+            if (slot == kEmpty) {
+                return i;
+            }
+            if (static_cast<uint32_t>(slot >> 32) == hash) {
+                const Record& record = records_[static_cast<uint32_t>(slot) - 1];
+                if (record.days == days && fio_of(record) == fio) {
+                    return i;
+                }
+            }
+        }
+    }
+
+    bool StudentStore::insert(uint16_t id, std::string_view fio, std::chrono::year_month_day birth_date) {
+        if ((records_.size() + 1) * 4 > slots_.size() * 3) {
+            grow();
+        }
+
+        const int32_t days = domain::to_days(birth_date);
+        const auto hash = static_cast<uint32_t>(domain::key_hash(fio, days));
+        const size_t slot = find_slot(fio, days, hash);
+        if (slots_[slot] != kEmpty) {
+            return false;
+        }
+
+        if (fio.size() > UINT16_MAX) {
+            throw std::length_error("FIO is too long for student store");
+        }
+        if (arena_.size() + fio.size() > UINT32_MAX) {
+            throw std::length_error("Student store FIO arena exceeds 4 GiB");
+        }
+
+        records_.push_back({ static_cast<uint32_t>(arena_.size()), hash, days, static_cast<uint16_t>(fio.size()), id });
+        arena_.append(fio);
+        slots_[slot] = (static_cast<uint64_t>(hash) << 32) | records_.size();
+        return true;
+    }
+
+    void StudentStore::insert_or_assign(const domain::Student& s) {
+        if (!slots_.empty()) {
+            const int32_t days = domain::to_days(s.birth_date);
+            const size_t slot = find_slot(s.fio, days, static_cast<uint32_t>(domain::key_hash(s.fio, days)));
+            if (slots_[slot] != kEmpty) {
+                records_[static_cast<uint32_t>(slots_[slot]) - 1].id = s.id;
+                return;
+            }
+        }
+        insert(s);
+    }
+
+    bool StudentStore::erase(std::string_view fio, std::chrono::year_month_day birth_date) {
+        if (slots_.empty()) {
+            return false;
+        }
+        const int32_t days = domain::to_days(birth_date);
+        const size_t slot = find_slot(fio, days, static_cast<uint32_t>(domain::key_hash(fio, days)));
+        if (slots_[slot] == kEmpty) {
+            return false;
+        }
+
+        const size_t index = static_cast<uint32_t>(slots_[slot]) - 1;
+        garbage_bytes_ += records_[index].fio_length;
+        erase_slot(slot);
+
+        // Последняя запись переносится на место удалённой, чтобы записи оставались сплошными
+        const size_t last = records_.size() - 1;
+        if (index != last) {
+            records_[index] = records_[last];
+            const size_t mask = slots_.size() - 1;
+            for (size_t i = home_slot(records_[index].hash); ; i = (i + 1) & mask) {
+                if (static_cast<uint32_t>(slots_[i]) == last + 1) {
+                    slots_[i] = (slots_[i] & ~uint64_t{ 0xFFFFFFFF }) | (index + 1);
+                    break;
+                }
+            }
+        }
+        records_.pop_back();
+
+        if (garbage_bytes_ > 4096 && garbage_bytes_ * 2 > arena_.size()) {
+            compact_arena();
+        }
+        return true;
+    }
+
+    std::optional<StudentStore::StudentView> StudentStore::find(std::string_view fio, std::chrono::year_month_day birth_date) const {
+        if (slots_.empty()) {
+            return std::nullopt;
+        }
+        const int32_t days = domain::to_days(birth_date);
+        const size_t slot = find_slot(fio, days, static_cast<uint32_t>(domain::key_hash(fio, days)));
+        if (slots_[slot] == kEmpty) {
+            return std::nullopt;
+        }
+        return view(records_[static_cast<uint32_t>(slots_[slot]) - 1]);
+    }
+
+    void StudentStore::merge(const StudentStore& other) {
+        reserve(size() + other.size(), arena_.size() + other.arena_.size());
+        for (const auto& record : other.records_) {
+            insert(record.id, other.fio_of(record), domain::from_days(record.days));
+        }
+    }
+
+    std::vector<domain::Student> StudentStore::to_students() const {
+        std::vector<domain::Student> students;
+        students.reserve(records_.size());
+        for (const auto& record : records_) {
+            students.push_back(view(record).to_student());
+        }
+        return students;
+    }
+
+    size_t StudentStore::memory_usage() const {
+        return records_.capacity() * sizeof(Record) + slots_.capacity() * sizeof(uint64_t) + arena_.capacity();
+    }
+
+    void StudentStore::grow() {
+        rehash(slots_.empty() ? 16 : slots_.size() * 2);
+    }
+
+    void StudentStore::rehash(size_t slot_count) {
+        if (slot_count > (size_t{ 1 } << 32)) {
+            throw std::length_error("Student store index exceeds 2^32 slots");
+        }
+        slots_.assign(slot_count, kEmpty);
+        shift_ = 32 - static_cast<unsigned>(std::countr_zero(slot_count));
+
+        const size_t mask = slot_count - 1;
+        for (size_t index = 0; index < records_.size(); ++index) {
+            size_t i = home_slot(records_[index].hash);
+            while (slots_[i] != kEmpty) {
+                i = (i + 1) & mask;
+            }
+            slots_[i] = (static_cast<uint64_t>(records_[index].hash) << 32) | (index + 1);
+        }
+    }
+
+    void StudentStore::erase_slot(size_t slot) {
+        // Удаление сдвигом назад: цепочка пробирования остаётся без "надгробий"
+        const size_t mask = slots_.size() - 1;
+        size_t hole = slot;
+        for (size_t j = (hole + 1) & mask; slots_[j] != kEmpty; j = (j + 1) & mask) {
+            const size_t home = home_slot(static_cast<uint32_t>(slots_[j] >> 32));
+            if (((j - home) & mask) >= ((j - hole) & mask)) {
+                slots_[hole] = slots_[j];
+                hole = j;
+            }
+        }
+        slots_[hole] = kEmpty;
+    }
+
+    void StudentStore::compact_arena() {
+        std::string compacted;
+        compacted.reserve(arena_.size() - garbage_bytes_);
+        for (auto& record : records_) {
+            const auto offset = static_cast<uint32_t>(compacted.size());
+            compacted.append(fio_of(record));
+            record.fio_offset = offset;
+        }
+        arena_.swap(compacted);
+        garbage_bytes_ = 0;
+    }
+}
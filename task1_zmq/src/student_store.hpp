@@ -0,0 +1,124 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "student.hpp"
+
+namespace data_loader
+{
+    // Множество студентов с ключом ФИО + дата рождения.
+    // Записи лежат подряд в одном векторе, байты ФИО - в общем буфере (arena),
+    // индекс - открытая адресация с линейным пробированием и удалением сдвигом назад.
+    class StudentStore
+    {
+    public:
+        // 16 байт на запись, ФИО задаётся смещением и длиной в arena
+        struct Record {
+            uint32_t fio_offset;
+            uint32_t hash;
+            int32_t days;
+            uint16_t fio_length;
+            uint16_t id;
+        };
+
+        // Представление записи; fio действителен до следующего изменения хранилища
+        struct StudentView {
+            uint16_t id;
+            std::string_view fio;
+            std::chrono::year_month_day birth_date;
+
+            domain::Student to_student() const { return { id, std::string(fio), birth_date }; }
+        };
+
+        class const_iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = StudentView;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = StudentView;
+
+            const_iterator() = default;
+            const_iterator(const StudentStore* store, const Record* record) : store_(store), record_(record) {}
+
+            StudentView operator*() const { return store_->view(*record_); }
+            const_iterator& operator++() { ++record_; return *this; }
+            const_iterator operator++(int) { auto copy = *this; ++record_; return copy; }
+            bool operator==(const const_iterator& other) const { return record_ == other.record_; }
+
+        private:
+            const StudentStore* store_ = nullptr;
+            const Record* record_ = nullptr;
+        };
+
+        StudentStore() = default;
+
+        template <typename It>
+        StudentStore(It first, It last) {
+            for (; first != last; ++first) {
+                insert(*first);
+            }
+        }
+
+        size_t size() const { return records_.size(); }
+        bool empty() const { return records_.empty(); }
+        void reserve(size_t count, size_t fio_bytes = 0);
+        void clear();
+
+        // Вставка без замены: существующая запись с тем же ключом сохраняется (первая побеждает)
+        bool insert(uint16_t id, std::string_view fio, std::chrono::year_month_day birth_date);
+        bool insert(const domain::Student& s) { return insert(s.id, s.fio, s.birth_date); }
+        bool insert(const StudentView& s) { return insert(s.id, s.fio, s.birth_date); }
+
+        // Вставка или замена ID у существующей записи
+        void insert_or_assign(const domain::Student& s);
+
+        bool erase(std::string_view fio, std::chrono::year_month_day birth_date);
+        bool erase(const domain::Student& s) { return erase(s.fio, s.birth_date); }
+
+        std::optional<StudentView> find(std::string_view fio, std::chrono::year_month_day birth_date) const;
+        bool contains(std::string_view fio, std::chrono::year_month_day birth_date) const {
+            return find(fio, birth_date).has_value();
+        }
+
+        // Добавляет записи other, ключей которых ещё нет (как unordered_set::merge)
+        void merge(const StudentStore& other);
+
+        const_iterator begin() const { return { this, records_.data() }; }
+        const_iterator end() const { return { this, records_.data() + records_.size() }; }
+
+        std::vector<domain::Student> to_students() const;
+
+        // Байты, занятые записями, индексом и arena
+        size_t memory_usage() const;
+
+    private:
+        static constexpr uint64_t kEmpty = 0;
+
+        StudentView view(const Record& record) const;
+        std::string_view fio_of(const Record& record) const {
+            return { arena_.data() + record.fio_offset, record.fio_length };
+        }
+
+        // Слот индекса: старшие 32 бита - хеш, младшие - номер записи + 1 (0 - пустой слот)
+        size_t home_slot(uint32_t hash) const { return hash >> shift_; }
+        size_t find_slot(std::string_view fio, int32_t days, uint32_t hash) const;
+        void grow();
+        void rehash(size_t slot_count);
+        void erase_slot(size_t slot);
+        void compact_arena();
+
+        std::vector<Record> records_;
+        std::vector<uint64_t> slots_;
+        std::string arena_;
+        size_t garbage_bytes_ = 0;
+        unsigned shift_ = 32;
+    };
+}
@@ -0,0 +1,182 @@
+#include "wire_format.hpp"
+#include <stdexcept>
+
+namespace wire
+{
+    namespace {
+        constexpr std::string_view kMagic = "STUD";
+        constexpr size_t kHeaderSize = 31;
+        constexpr size_t kRecordFixedSize = 2 + 4 + 2;
+
+        void put_u16(std::string& out, uint16_t v) {
+            out.push_back(static_cast<char>(v & 0xFF));
+            out.push_back(static_cast<char>(v >> 8));
+        }
+
+        void put_u32(std::string& out, uint32_t v) {
+            for (int shift = 0; shift < 32; shift += 8) {
+                out.push_back(static_cast<char>((v >> shift) & 0xFF));
+            }
+        }
+
+        void put_u64(std::string& out, uint64_t v) {
+            put_u32(out, static_cast<uint32_t>(v));
+            put_u32(out, static_cast<uint32_t>(v >> 32));
+        }
+
+        uint16_t get_u16(const unsigned char* p) {
+            return static_cast<uint16_t>(p[0] | (p[1] << 8));
+        }
+
+        uint32_t get_u32(const unsigned char* p) {
+            return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+                (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+        }
+
+        uint64_t get_u64(const unsigned char* p) {
+            return static_cast<uint64_t>(get_u32(p)) | (static_cast<uint64_t>(get_u32(p + 4)) << 32);
+        }
+
+        std::string encode_binary(const std::vector<domain::Student>& students) {
+            size_t total = 4;
+            for (const auto& s : students) {
+                total += kRecordFixedSize + s.fio.size();
+            }
+
+            std::string out;
+            out.reserve(total);
+            put_u32(out, static_cast<uint32_t>(students.size()));
+            for (const auto& s : students) {
+                if (s.fio.size() > UINT16_MAX) {
+                    throw std::runtime_error("FIO is too long for binary encoding: " + s.fio.substr(0, 64));
+                }
+                const auto days = std::chrono::sys_days{ s.birth_date }.time_since_epoch().count();
+                put_u16(out, s.id);
+                put_u32(out, static_cast<uint32_t>(static_cast<int32_t>(days)));
+                put_u16(out, static_cast<uint16_t>(s.fio.size()));
+                out.append(s.fio);
+            }
+            return out;
+        }
+
+        std::vector<domain::Student> decode_binary(std::string_view payload) {
+            std::vector<domain::Student> students;
+            if (payload.size() >= 4) {
+                students.reserve(get_u32(reinterpret_cast<const unsigned char*>(payload.data())));
+            }
+            visit_binary_students(payload, [&](uint16_t id, std::string_view fio, std::chrono::year_month_day birth_date) {
+                students.push_back({ id, std::string(fio), birth_date });
+            });
+            return students;
+        }
+    }
+
+    void visit_binary_students(std::string_view payload, const StudentVisitor& visitor) {
+        const auto* p = reinterpret_cast<const unsigned char*>(payload.data());
+        const auto* end = p + payload.size();
+
+        if (payload.size() < 4) {
+            throw std::runtime_error("Binary payload is truncated");
+        }
+        const uint32_t count = get_u32(p);
+        p += 4;
+        // Каждая запись занимает не меньше kRecordFixedSize байт
+        if (count > static_cast<size_t>(end - p) / kRecordFixedSize) {
+            throw std::runtime_error("Binary payload record count exceeds payload size");
+        }
+
+        for (uint32_t i = 0; i < count; ++i) {
+            if (end - p < static_cast<std::ptrdiff_t>(kRecordFixedSize)) {
+                throw std::runtime_error("Binary payload is truncated");
+            }
+            const uint16_t id = get_u16(p);
+            const auto days = static_cast<int32_t>(get_u32(p + 2));
+            const uint16_t fio_len = get_u16(p + 6);
+            p += kRecordFixedSize;
+            if (end - p < fio_len) {
+                throw std::runtime_error("Binary payload is truncated");
+            }
+            const std::string_view fio(reinterpret_cast<const char*>(p), fio_len);
+            p += fio_len;
+            const std::chrono::year_month_day birth_date{ std::chrono::sys_days{ std::chrono::days{ days } } };
+            if (!birth_date.ok()) {
+                throw std::runtime_error("Invalid birth date in binary payload");
+            }
+            visitor(id, fio, birth_date);
+        }
+        if (p != end) {
+            throw std::runtime_error("Unexpected trailing bytes in binary payload");
+        }
+    }
+
+    std::string encode_header(const Header& header) {
+        std::string out(kMagic);
+        out.reserve(kHeaderSize);
+        out.push_back(static_cast<char>(header.version));
+        out.push_back(static_cast<char>(header.format));
+        out.push_back(static_cast<char>(header.kind));
+        put_u64(out, header.sequence);
+        put_u64(out, header.timestamp_us);
+        put_u64(out, header.source);
+        return out;
+    }
+
+    std::optional<Header> decode_header(std::string_view frame) {
+        if (frame.size() != kHeaderSize || frame.substr(0, kMagic.size()) != kMagic) {
+            return std::nullopt;
+        }
+        Header header;
+        header.version = static_cast<uint8_t>(frame[4]);
+        header.format = static_cast<Format>(frame[5]);
+        header.kind = static_cast<MessageKind>(frame[6]);
+        header.sequence = get_u64(reinterpret_cast<const unsigned char*>(frame.data()) + 7);
+        header.timestamp_us = get_u64(reinterpret_cast<const unsigned char*>(frame.data()) + 15);
+        header.source = get_u64(reinterpret_cast<const unsigned char*>(frame.data()) + 23);
+        return header;
+    }
+
+    std::string encode_students(const std::vector<domain::Student>& students, Format format) {
+        if (format == Format::Json) {
+            nlohmann::json j_students = students;
+            return j_students.dump();
+        }
+        return encode_binary(students);
+    }
+
+    std::vector<domain::Student> decode_students(std::string_view payload, Format format) {
+        switch (format) {
+        case Format::Json:
+            return nlohmann::json::parse(payload).get<std::vector<domain::Student>>();
+        case Format::Binary:
+            return decode_binary(payload);
+        }
+        throw std::runtime_error("Unknown payload format: " + std::to_string(static_cast<int>(format)));
+    }
+
+    std::string topic_of(std::string_view fio) {
+        if (fio.empty()) {
+            return {};
+        }
+        const auto lead = static_cast<unsigned char>(fio.front());
+        size_t length = 1;
+        if ((lead & 0xE0) == 0xC0) length = 2;
+        else if ((lead & 0xF0) == 0xE0) length = 3;
+        else if ((lead & 0xF8) == 0xF0) length = 4;
+
+        std::string topic(fio.substr(0, length));
+        if (lead >= 'a' && lead <= 'z') {
+            topic[0] = static_cast<char>(lead - 'a' + 'A');
+        }
+        return topic;
+    }
+
+    std::optional<Format> parse_format(std::string_view name) {
+        if (name == "binary") return Format::Binary;
+        if (name == "json") return Format::Json;
+        return std::nullopt;
+    }
+
+    std::string_view format_name(Format format) {
+        return format == Format::Json ? "json" : "binary";
+    }
+}
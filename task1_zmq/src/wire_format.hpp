@@ -0,0 +1,61 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "student.hpp"
+
+namespace wire
+{
+    // Формат полезной нагрузки. Binary - основной, Json - для отладки
+    enum class Format : uint8_t { Json = 0, Binary = 1 };
+
+    // Snapshot - отсортированный фрагмент полного набора темы (ответ на запрос снимка),
+    // Delta - кадры добавленных и удалённых записей,
+    // Heartbeat - только текущий номер последовательности,
+    // SnapshotBegin/SnapshotEnd - границы потока фрагментов снимка
+    enum class MessageKind : uint8_t { Snapshot = 0, Delta = 1, Heartbeat = 2, SnapshotBegin = 3, SnapshotEnd = 4 };
+
+    constexpr uint8_t kVersion = 4;
+
+    // Запрос полного снимка по сокету снимков (шаблон Clone из руководства ZeroMQ)
+    constexpr std::string_view kSnapshotRequest = "ICANHAZ?";
+
+    // Заголовочный кадр сообщения: сигнатура "STUD", версия, формат, вид сообщения,
+    // u64 номер последовательности, u64 время отправки (микросекунды от эпохи UNIX),
+    // u64 идентификатор экземпляра сервера (различает источники за прокси и перезапуски сервера)
+    struct Header {
+        uint8_t version = kVersion;
+        Format format = Format::Binary;
+        MessageKind kind = MessageKind::Snapshot;
+        uint64_t sequence = 0;
+        uint64_t timestamp_us = 0;
+        uint64_t source = 0;
+    };
+
+    std::string encode_header(const Header& header);
+    // nullopt, если кадр не является заголовком (например, сообщение старого сервера)
+    std::optional<Header> decode_header(std::string_view frame);
+
+    // Binary: u32 count, далее на запись u16 id, i32 дней от 1970-01-01, u16 длина ФИО, байты ФИО.
+    // Все числа little-endian
+    std::string encode_students(const std::vector<domain::Student>& students, Format format);
+    // Бросает std::runtime_error при повреждённых данных
+    std::vector<domain::Student> decode_students(std::string_view payload, Format format);
+
+    // Разбор Binary-нагрузки без выделения памяти под записи: visitor вызывается для каждой записи,
+    // fio указывает внутрь payload. Бросает std::runtime_error при повреждённых данных
+    using StudentVisitor = std::function<void(uint16_t id, std::string_view fio, std::chrono::year_month_day birth_date)>;
+    void visit_binary_students(std::string_view payload, const StudentVisitor& visitor);
+
+    // Тема сообщения - первый символ ФИО (UTF-8), латиница приводится к верхнему регистру.
+    // Используется как первый кадр для фильтрации подписок на стороне ZMQ
+    std::string topic_of(std::string_view fio);
+
+    std::optional<Format> parse_format(std::string_view name);
+    std::string_view format_name(Format format);
+}
@@ -0,0 +1,125 @@
+// load_all_students_external против load_all_students на сгенерированном каталоге: те же записи в порядке
+// Student::order (при совпадении ключа в разных файлах побеждает та же запись), те же счётчики строк.
+// Минимальный бюджет памяти даёт несколько прогонов на диске. Затем diff_students по файлам
+// сравнивается с diff_students по наборам после изменения каталога.
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "external_sort.hpp"
+
+namespace
+{
+    namespace fs = std::filesystem;
+
+    int failures = 0;
+
+    void fail(const std::string& what) {
+        if (failures++ < 10) {
+            std::cerr << what << std::endl;
+        }
+    }
+
+    bool same_records(const std::vector<domain::Student>& a, const std::vector<domain::Student>& b) {
+        return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const domain::Student& x, const domain::Student& y) {
+            return x.id == y.id && x.fio == y.fio && x.birth_date == y.birth_date;
+        });
+    }
+
+    std::vector<domain::Student> sorted_students(const data_loader::StudentSet& set) {
+        auto students = set.to_students();
+        std::sort(students.begin(), students.end(), domain::Student::order{});
+        return students;
+    }
+
+    std::vector<domain::Student> read_all(const data_loader::SortedRunFile& file) {
+        std::vector<domain::Student> students;
+        file.for_each([&](domain::Student&& student) { students.push_back(std::move(student)); });
+        return students;
+    }
+
+    std::vector<domain::Student> sorted_copy(std::vector<domain::Student> students) {
+        std::sort(students.begin(), students.end(), domain::Student::order{});
+        return students;
+    }
+
+    // Файлы со случайными строками: частые повторы ключей внутри файла и между файлами (проверяется,
+    // какая запись побеждает), строчные и прописные первые буквы, кириллица и отбраковываемые строки
+    void write_files(const fs::path& dir, std::mt19937& rng, int files) {
+        const char* names[] = { "Ivanov Ivan", "ivanov ivan", "Petrov Petr", "Sidorova Anna", "Zaitsev Oleg",
+            "\xD0\x98\xD0\xB2\xD0\xB0\xD0\xBD\xD0\xBE\xD0\xB2 \xD0\x98\xD0\xB2\xD0\xB0\xD0\xBD", "abramov Boris" };
+        for (int f = 0; f < files; ++f) {
+            std::ofstream out(dir / ("students_" + std::to_string(f) + ".txt"), std::ios::binary);
+            for (int i = 0; i < 25000; ++i) {
+                const unsigned kind = rng() % 50;
+                if (kind == 0) {
+                    out << "not a student line\n";
+                    continue;
+                }
+                if (kind == 1) {
+                    out << "70000 Out Of Range 01.01.2000\n";
+                    continue;
+                }
+                const unsigned day = 1 + rng() % 28;
+                const unsigned month = 1 + rng() % 2;
+                out << rng() % 65536 << ' ' << names[rng() % std::size(names)] << ' '
+                    << static_cast<char>('a' + rng() % 8) << static_cast<char>('a' + rng() % 8) << ' '
+                    << (day < 10 ? "0" : "") << day << '.' << (month < 10 ? "0" : "") << month << '.'
+                    << "1950\n";
+            }
+        }
+    }
+}
+
+int main() {
+    const fs::path dir = fs::temp_directory_path() / ("external_sort_test_" + std::to_string(std::random_device{}()));
+    fs::create_directories(dir);
+    std::mt19937 rng(5);
+    write_files(dir, rng, 8);
+
+    data_loader::ExternalOptions external_options;
+    external_options.memory_budget = 1 << 20;
+    external_options.spill_dir = dir.string();
+
+    data_loader::LoadStats memory_stats;
+    data_loader::LoadStats external_stats;
+    const auto set = data_loader::load_all_students(dir.string(), {}, &memory_stats);
+    const auto file = data_loader::load_all_students_external(dir.string(), external_options, &external_stats);
+
+    if (file.size() != set.size()) {
+        fail("size " + std::to_string(file.size()) + " != " + std::to_string(set.size()));
+    }
+    if (!same_records(read_all(file), sorted_students(set))) {
+        fail("external records differ from load_all_students");
+    }
+    if (external_stats.files != memory_stats.files || external_stats.lines != memory_stats.lines ||
+        external_stats.rejected != memory_stats.rejected || external_stats.rejected_by_reason != memory_stats.rejected_by_reason) {
+        fail("external load stats differ from load_all_students");
+    }
+
+    // Изменение каталога: новый файл и перезапись существующего
+    write_files(dir, rng, 2);
+    std::ofstream(dir / "students_extra.txt") << "1 Extra Student 01.01.2001\n2 Ivanov Ivan ab 01.01.1950\n";
+    const auto set_after = data_loader::load_all_students(dir.string());
+    const auto file_after = data_loader::load_all_students_external(dir.string(), external_options);
+    const auto set_delta = data_loader::diff_students(set, set_after);
+    const auto file_delta = data_loader::diff_students(file, file_after);
+    if (!same_records(sorted_copy(file_delta.added), sorted_copy(set_delta.added)) ||
+        !same_records(sorted_copy(file_delta.removed), sorted_copy(set_delta.removed))) {
+        fail("external diff_students differs from the in-memory one");
+    }
+
+    std::error_code ec;
+    fs::remove_all(dir, ec);
+
+    if (failures > 0) {
+        std::cerr << failures << " failures" << std::endl;
+        return 1;
+    }
+    std::cout << "external_sort_test: OK" << std::endl;
+    return 0;
+}
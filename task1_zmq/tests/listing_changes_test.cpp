@@ -0,0 +1,99 @@
+// Отсортированные списки клиента против StudentSet: apply_changes после серии случайных StudentDelta
+// совпадает с apply_delta + сортировкой, merge_listings - с StudentSet::merge в порядке списков.
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "data_loader.hpp"
+
+namespace
+{
+    using data_loader::StudentSet;
+
+    int failures = 0;
+
+    void fail(const std::string& what, size_t step) {
+        if (failures++ < 10) {
+            std::cerr << "step " << step << ": " << what << std::endl;
+        }
+    }
+
+    std::vector<domain::Student> sorted_students(const StudentSet& set) {
+        auto students = set.to_students();
+        std::sort(students.begin(), students.end(), domain::Student::order{});
+        return students;
+    }
+
+    bool same_records(const std::vector<domain::Student>& a, const std::vector<domain::Student>& b) {
+        return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const domain::Student& x, const domain::Student& y) {
+            return x.id == y.id && x.fio == y.fio && x.birth_date == y.birth_date;
+        });
+    }
+
+    // Ключи с общими ФИО и разными датами, чтобы равенство ФИО не означало равенства ключа
+    domain::Student random_student(std::mt19937& rng) {
+        return { static_cast<uint16_t>(rng()), "Student " + std::to_string(rng() % 300),
+            domain::from_days(static_cast<int32_t>(3650 + rng() % 3 * 365)) };
+    }
+
+    data_loader::StudentDelta random_delta(std::mt19937& rng) {
+        data_loader::StudentDelta delta;
+        for (size_t i = rng() % 20; i > 0; --i) {
+            delta.added.push_back(random_student(rng));
+        }
+        for (size_t i = rng() % 20; i > 0; --i) {
+            delta.removed.push_back(random_student(rng));
+        }
+        return delta;
+    }
+}
+
+int main() {
+    std::mt19937 rng(11);
+
+    // Изменения накапливаются по несколько дельт, как при пропуске промежуточных состояний клиентом
+    StudentSet reference;
+    std::vector<domain::Student> listing;
+    for (size_t step = 0; step < 2000 && failures == 0; ++step) {
+        data_loader::ListingChanges changes;
+        for (size_t i = 1 + rng() % 4; i > 0; --i) {
+            const auto delta = random_delta(rng);
+            data_loader::apply_delta(reference, delta);
+            data_loader::accumulate_delta(changes, delta);
+        }
+        listing = data_loader::apply_changes(listing, changes);
+        if (!same_records(listing, sorted_students(reference))) {
+            fail("apply_changes differs from apply_delta", step);
+        }
+    }
+
+    // Слияние списков нескольких серверов: при совпадении ключа побеждает более ранний список
+    for (size_t step = 0; step < 200 && failures == 0; ++step) {
+        std::vector<std::vector<domain::Student>> parts(1 + rng() % 4);
+        StudentSet merged;
+        for (auto& part : parts) {
+            StudentSet set;
+            for (size_t i = rng() % 200; i > 0; --i) {
+                set.insert(random_student(rng));
+            }
+            part = sorted_students(set);
+            merged.merge(set);
+        }
+        std::vector<const std::vector<domain::Student>*> pointers;
+        for (const auto& part : parts) {
+            pointers.push_back(&part);
+        }
+        if (!same_records(data_loader::merge_listings(pointers), sorted_students(merged))) {
+            fail("merge_listings differs from StudentSet::merge", step);
+        }
+    }
+
+    if (failures > 0) {
+        std::cerr << failures << " failures" << std::endl;
+        return 1;
+    }
+    std::cout << "listing_changes_test: OK" << std::endl;
+    return 0;
+}
@@ -0,0 +1,203 @@
+// Очереди клиентского конвейера и журнала отбраковки: порядок и целостность значений между потоками,
+// заполнение и опустошение кольцевого буфера, конфляция LatestValue, пробуждение ждущего потребителя
+// значением и закрытием.
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "spsc_queue.hpp"
+
+namespace
+{
+    int failures = 0;
+
+    void fail(const std::string& what) {
+        if (failures++ < 10) {
+            std::cerr << what << std::endl;
+        }
+    }
+
+    // Производитель и потребитель в одном потоке: ёмкость, порядок, повторное использование ячеек после оборота
+    void test_spsc_single_thread() {
+        util::SpscQueue<std::string> queue(5);
+        if (queue.capacity() != 8) {
+            fail("spsc: capacity is not rounded up to a power of two");
+        }
+        for (int round = 0; round < 3; ++round) {
+            for (int i = 0; i < 8; ++i) {
+                if (!queue.try_push(std::to_string(round * 8 + i))) {
+                    fail("spsc: push into a non-full queue failed");
+                }
+            }
+            std::string extra = "extra";
+            if (queue.try_push(std::move(extra)) || extra != "extra") {
+                fail("spsc: push into a full queue must fail and keep the value");
+            }
+            if (queue.size() != 8) {
+                fail("spsc: size of a full queue");
+            }
+            for (int i = 0; i < 8; ++i) {
+                auto value = queue.try_pop();
+                if (!value || *value != std::to_string(round * 8 + i)) {
+                    fail("spsc: values out of order");
+                }
+            }
+            if (queue.try_pop() || !queue.empty()) {
+                fail("spsc: queue is not empty after popping everything");
+            }
+        }
+    }
+
+    // Производитель и потребитель в разных потоках, потребитель ждёт в wait_pop до закрытия
+    void test_spsc_threads() {
+        constexpr uint64_t kCount = 200000;
+        util::SpscQueue<uint64_t> queue(64);
+        std::thread producer([&] {
+            for (uint64_t i = 1; i <= kCount; ++i) {
+                uint64_t value = i;
+                while (!queue.try_push(std::move(value))) {
+                    std::this_thread::yield();
+                }
+            }
+            queue.close();
+        });
+
+        uint64_t expected = 1;
+        while (auto value = queue.wait_pop()) {
+            if (*value != expected) {
+                fail("spsc threads: got " + std::to_string(*value) + ", expected " + std::to_string(expected));
+                break;
+            }
+            ++expected;
+        }
+        producer.join();
+        if (expected != kCount + 1) {
+            fail("spsc threads: received " + std::to_string(expected - 1) + " of " + std::to_string(kCount));
+        }
+        if (queue.wait_pop()) {
+            fail("spsc threads: wait_pop on a closed empty queue must return nullopt");
+        }
+    }
+
+    // Закрытие пустой очереди будит потребителя, уже уснувшего в wait_pop
+    void test_spsc_close_wakes() {
+        util::SpscQueue<int> queue(4);
+        std::atomic<bool> returned{ false };
+        std::thread consumer([&] {
+            if (queue.wait_pop()) {
+                fail("spsc close: unexpected value");
+            }
+            returned = true;
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        if (returned) {
+            fail("spsc close: wait_pop returned before close");
+        }
+        queue.close();
+        consumer.join();
+    }
+
+    // Несколько производителей, потребитель в wait_pop: каждое значение получено ровно один раз,
+    // порядок каждого производителя сохранён
+    void test_mpsc_threads() {
+        constexpr int kProducers = 4;
+        constexpr uint64_t kPerProducer = 50000;
+        util::MpscQueue<uint64_t> queue(128);
+        std::vector<std::thread> producers;
+        for (int p = 0; p < kProducers; ++p) {
+            producers.emplace_back([&, p] {
+                for (uint64_t i = 0; i < kPerProducer; ++i) {
+                    uint64_t value = (static_cast<uint64_t>(p) << 32) | i;
+                    while (!queue.try_push(std::move(value))) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+
+        std::vector<uint64_t> next(kProducers, 0);
+        uint64_t received = 0;
+        while (received < kProducers * kPerProducer) {
+            auto value = queue.wait_pop();
+            if (!value) {
+                fail("mpsc: wait_pop returned nothing before close");
+                break;
+            }
+            const auto producer = static_cast<size_t>(*value >> 32);
+            const uint64_t index = *value & 0xFFFFFFFFu;
+            if (producer >= next.size() || index != next[producer]) {
+                fail("mpsc: unexpected value from producer " + std::to_string(producer));
+                break;
+            }
+            ++next[producer];
+            ++received;
+        }
+        for (auto& producer : producers) {
+            producer.join();
+        }
+        if (queue.try_pop() || !queue.empty()) {
+            fail("mpsc: queue is not empty after all values were received");
+        }
+        queue.close();
+        if (queue.wait_pop()) {
+            fail("mpsc: wait_pop on a closed empty queue must return nullopt");
+        }
+    }
+
+    // Новое значение вытесняет незабранное; wait_take отдаёт последнее, после закрытия - nullptr
+    void test_latest_value() {
+        util::LatestValue<std::string> slot;
+        if (slot.take() || slot.has_value()) {
+            fail("latest: a new slot must be empty");
+        }
+        if (slot.publish("a")) {
+            fail("latest: the first publish replaced nothing");
+        }
+        if (!slot.publish("b")) {
+            fail("latest: the second publish must report conflation");
+        }
+        auto value = slot.take();
+        if (!value || *value != "b" || slot.has_value()) {
+            fail("latest: take must return the newest value");
+        }
+
+        constexpr int kCount = 100000;
+        util::LatestValue<int> latest;
+        std::thread producer([&] {
+            for (int i = 1; i <= kCount; ++i) {
+                latest.publish(i);
+            }
+            latest.close();
+        });
+        int last = 0;
+        while (auto taken = latest.wait_take()) {
+            if (*taken <= last) {
+                fail("latest threads: values must only grow");
+                break;
+            }
+            last = *taken;
+        }
+        producer.join();
+        if (last != kCount) {
+            fail("latest threads: the final value was lost (" + std::to_string(last) + ")");
+        }
+    }
+}
+
+int main() {
+    test_spsc_single_thread();
+    test_spsc_threads();
+    test_spsc_close_wakes();
+    test_mpsc_threads();
+    test_latest_value();
+
+    if (failures > 0) {
+        std::cerr << failures << " failures" << std::endl;
+        return 1;
+    }
+    std::cout << "spsc_queue_test: OK" << std::endl;
+    return 0;
+}
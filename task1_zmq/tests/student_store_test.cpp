@@ -0,0 +1,145 @@
+// StudentStore против std::unordered_map по ключу ФИО + дата рождения: случайные вставки, замены ID,
+// удаления и поиски. Малый набор ключей даёт длинные цепочки пробирования (удаление сдвигом назад),
+// удаления не последней записи - перенос последней на её место, длинные ФИО - уплотнение arena.
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "student_store.hpp"
+
+namespace
+{
+    using data_loader::StudentStore;
+
+    struct Key {
+        std::string fio;
+        int32_t days = 0;
+        bool operator==(const Key&) const = default;
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const { return static_cast<size_t>(domain::key_hash(key.fio, key.days)); }
+    };
+
+    using Reference = std::unordered_map<Key, uint16_t, KeyHash>;
+
+    int failures = 0;
+
+    void fail(const std::string& what, size_t step) {
+        if (failures++ < 10) {
+            std::cerr << "step " << step << ": " << what << std::endl;
+        }
+    }
+
+    // Содержимое хранилища совпадает с эталоном: размер, обход, поиск каждого ключа
+    void check_contents(const StudentStore& store, const Reference& reference, size_t step) {
+        if (store.size() != reference.size()) {
+            fail("size " + std::to_string(store.size()) + " != " + std::to_string(reference.size()), step);
+            return;
+        }
+        size_t visited = 0;
+        for (const auto student : store) {
+            const auto it = reference.find({ std::string(student.fio), domain::to_days(student.birth_date) });
+            if (it == reference.end() || it->second != student.id) {
+                fail("iteration yields an unknown record " + std::string(student.fio), step);
+                return;
+            }
+            ++visited;
+        }
+        if (visited != reference.size()) {
+            fail("iteration count", step);
+        }
+        for (const auto& [key, id] : reference) {
+            const auto found = store.find(key.fio, domain::from_days(key.days));
+            if (!found || found->id != id || found->fio != key.fio) {
+                fail("find misses " + key.fio, step);
+                return;
+            }
+        }
+    }
+}
+
+int main() {
+    std::mt19937 rng(7);
+
+    // Ключи: короткие ФИО с общими префиксами и длинные (уплотнение arena после удалений)
+    std::vector<Key> keys;
+    for (int i = 0; i < 3000; ++i) {
+        std::string fio = "Student " + std::to_string(i % 700);
+        if (i % 5 == 0) {
+            fio += std::string(40 + i % 200, 'x');
+        }
+        keys.push_back({ fio, static_cast<int32_t>(i / 700 * 365 + 3650) });
+    }
+
+    StudentStore store;
+    Reference reference;
+    for (size_t step = 0; step < 200000 && failures == 0; ++step) {
+        const Key& key = keys[rng() % keys.size()];
+        const auto birth_date = domain::from_days(key.days);
+        const auto id = static_cast<uint16_t>(rng());
+        // Доля вставок колеблется, чтобы хранилище многократно росло и опустошалось
+        const bool grow_phase = (step / 20000) % 2 == 0;
+        const unsigned op = rng() % 10;
+
+        if (op < (grow_phase ? 5u : 2u)) {
+            const bool inserted = store.insert(id, key.fio, birth_date);
+            const bool expected = reference.emplace(key, id).second;
+            if (inserted != expected) {
+                fail("insert result for " + key.fio, step);
+            }
+        }
+        else if (op < 4) {
+            store.insert_or_assign({ id, key.fio, birth_date });
+            reference[key] = id;
+        }
+        else if (op < 8) {
+            const bool erased = store.erase(key.fio, birth_date);
+            if (erased != (reference.erase(key) == 1)) {
+                fail("erase result for " + key.fio, step);
+            }
+        }
+        else {
+            const auto found = store.find(key.fio, birth_date);
+            const auto it = reference.find(key);
+            if (found.has_value() != (it != reference.end()) || (found && found->id != it->second)) {
+                fail("find result for " + key.fio, step);
+            }
+        }
+
+        if (step % 997 == 0) {
+            check_contents(store, reference, step);
+        }
+    }
+    check_contents(store, reference, 200000);
+
+    // merge оставляет существующие записи, to_students и clear согласованы с содержимым
+    StudentStore other;
+    Reference merged = reference;
+    for (int i = 0; i < 500; ++i) {
+        const Key& key = keys[rng() % keys.size()];
+        const auto id = static_cast<uint16_t>(rng());
+        if (other.insert(id, key.fio, domain::from_days(key.days))) {
+            merged.emplace(key, id);
+        }
+    }
+    store.merge(other);
+    check_contents(store, merged, 200001);
+    if (store.to_students().size() != merged.size()) {
+        fail("to_students size", 200002);
+    }
+    store.clear();
+    check_contents(store, {}, 200003);
+    if (!store.insert(1, keys.front().fio, domain::from_days(keys.front().days))) {
+        fail("insert after clear", 200004);
+    }
+
+    if (failures > 0) {
+        std::cerr << failures << " failures" << std::endl;
+        return 1;
+    }
+    std::cout << "student_store_test: OK" << std::endl;
+    return 0;
+}
@@ -0,0 +1,499 @@
+// Бенчмарк поиска координат: прежний поиск через std::regex (GEO_PAIR_REGEX и разбор компонентов
+// через std::stringstream) против однопроходного geo::scan_coordinates, а также прежний поиск
+// контекста и меток (просмотр текста на каждое совпадение) против geo::DocumentIndex, а также полный
+// анализ документа в одном потоке против параллельного анализа по отрезкам и сборка ответа через
+// nlohmann::json с dump(4) против geo::JsonWriter, приём тела запроса через DOM против geo::extract_text_field.
+// Входные тексты повторяются --scale раз, чтобы получить документ нужного размера.
+// Каждый результат - одна строка "этап ключ=значение ...", пригодная для разбора скриптом.
+// Пример: geo_bench --data data/text1.txt data/text2.txt --scale 200
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+#include "CLI/CLI.hpp"
+#include "coord_scanner.hpp"
+#include "document_index.hpp"
+#include "geo_analyzer.hpp"
+#include "request_text.hpp"
+
+namespace legacy
+{
+    // Поиск пар из analyze_geo_text до перехода на geo::scan_coordinates (без контекста и меток)
+    /**
+     * @brief Преобразует градусы, минуты, секунды в десятичные градусы.
+     * @return Значение в десятичных градусах.
+     */
+    static double dms_to_dd(double deg, double min, double sec) {
+        return deg + min / 60.0 + sec / 3600.0;
+    }
+
+    /**
+     * @brief Нормализует строку компонента координаты и извлекает DD.
+     *
+     * @param geo_str Строка компонента (например, "76°00′00″ с.ш.", "N80.4551").
+     * @param is_latitude Флаг, указывающий, является ли это широтой (true) или долготой (false).
+     * @param format Ссылка для записи определенного формата.
+     * @return Значение в десятичных градусах, 999.0 в случае ошибки/невалидности.
+     */
+    static double normalize_and_validate_component(const std::string& geo_str, bool is_latitude, std::string& format) {
+        std::string s = geo_str;
+        // Заменяем русские запятые на точки и удаляем символы, которые могли быть захвачены
+        std::replace(s.begin(), s.end(), ',', '.');
+
+        // Находим направление (N, S, E, W, С, Ю, В, З)
+        char direction = ' ';
+        std::string clean_val;
+    
+        // Ищем направление и очищаем от знаков препинания и букв.
+        // Прежний код сравнивал char ещё и с многобайтовыми 'Ю', 'В', 'З' - такое сравнение всегда ложно,
+        // русские направления здесь не учитывались; эти сравнения опущены, поведение то же
+        for (char c : s) {
+            if (std::isalpha(static_cast<unsigned char>(c))) {
+                char upper_c = std::toupper(static_cast<unsigned char>(c));
+                if (is_latitude) {
+                    if (upper_c == 'N' || upper_c == 'S' || upper_c == 'C') {
+                        direction = (direction == ' ') ? upper_c : direction;
+                    }
+                } else { // Долгота
+                    if (upper_c == 'E' || upper_c == 'W') {
+                        direction = (direction == ' ') ? upper_c : direction;
+                    }
+                }
+            }
+            if (std::isdigit(c) || c == '.' || c == ' ' || c == '-') {
+                clean_val += c;
+            }
+        }
+
+        // Удаляем лишние пробелы и очищаем от множественных пробелов
+        std::stringstream val_ss(clean_val);
+        std::vector<double> parts;
+        double p;
+        while (val_ss >> p) {
+            parts.push_back(p);
+        }
+
+        double dd = 0.0;
+
+        if (parts.size() == 1) { // Decimal Degrees (DD)
+            dd = parts[0];
+            format = "DD";
+        } else if (parts.size() == 2) { // Degrees Decimal Minutes (DDM) - Deg Min.min
+            if (parts[1] >= 60.0) return 999.0; // Минуты >= 60
+            dd = dms_to_dd(parts[0], parts[1], 0.0);
+            format = "DDM";
+        } else if (parts.size() == 3) { // Degrees Minutes Seconds (DMS) - Deg Min Sec
+            if (parts[1] >= 60.0 || parts[2] >= 60.0) return 999.0; // Минуты/секунды >= 60
+            dd = dms_to_dd(parts[0], parts[1], parts[2]);
+            format = "DMS";
+        } else {
+            return 999.0; // Неизвестный формат
+        }
+
+        // Применяем знак, если есть направление (Юг/Запад -> отрицательное значение)
+        if (direction == 'S' || direction == 'W') {
+            dd = -std::abs(dd);
+        } else {
+            dd = std::abs(dd);
+        }
+
+        // Проверка на валидность (границы)
+        double max_val = is_latitude ? 90.0 : 180.0;
+        if (std::abs(dd) > max_val) {
+            return 999.0; // Недопустимое значение
+        }
+
+        return dd;
+    }
+
+    static size_t find_coordinates(const std::string& text) {
+        const std::regex GEO_PAIR_REGEX(
+            R"(([NSСЮЕWВЗ]?)\s*([\d]{1,3}[°\s']?[\d]{0,2}[.,\s']?[\d]{0,6}[′"\s]?[.,\s']?[\d]{0,6}[″"\s']?)([NSСЮЕWВЗ]?)\s*([\s,\-\/\;]{1,10}|\b(?:и\s|или\s|через\s|и\sточка\s){1,4}\b)\s*([NSСЮЕWВЗ]?)\s*([\d]{1,3}[°\s']?[\d]{0,2}[.,\s']?[\d]{0,6}[′"\s]?[.,\s']?[\d]{0,6}[″"\s']?)([NSСЮЕWВЗ]?))"
+            , std::regex::icase | std::regex::optimize
+        );
+
+        size_t found = 0;
+        auto it = text.cbegin();
+        std::smatch match;
+        while (std::regex_search(it, text.cend(), match, GEO_PAIR_REGEX)) {
+            std::string dir_lat = match[1].str() + match[3].str();
+            std::string dir_lon = match[5].str() + match[7].str();
+            std::string format1, format2;
+            double lat_dd = normalize_and_validate_component(match[2].str() + dir_lat, true, format1);
+            double lon_dd = normalize_and_validate_component(match[6].str() + dir_lon, false, format2);
+            if (lat_dd != 999.0 && lon_dd != 999.0) {
+                ++found;
+            }
+            it = match[0].second;
+        }
+        return found;
+    }
+
+    // Ответ /analyze до перехода на geo::JsonWriter: DOM nlohmann::json и dump(4)
+    static std::string to_json_dom(const geo::GeoAnalysis& analysis) {
+        using json = nlohmann::json;
+        json response = {
+            {"coordinate_type", std::string(analysis.coordinate_type)},
+            {"total_found", analysis.coordinates.size()},
+            {"coordinates", json::array()}
+        };
+
+        for (const auto& coord : analysis.coordinates) {
+            // Форматируем DD для вывода с 4 знаками после запятой
+            std::ostringstream ss;
+            ss << std::fixed << std::setprecision(4)
+               << std::abs(coord.lat_dd) << (coord.lat_dd >= 0 ? "N" : "S") << " "
+               << std::abs(coord.lon_dd) << (coord.lon_dd >= 0 ? "E" : "W");
+            std::string normalized_dd = ss.str();
+
+            std::string context(coord.sentence_context);
+            if (coord.context_truncated) {
+                context += "...";
+            }
+
+            response["coordinates"].push_back({
+                {"original", std::string(coord.original_text)},
+                {"normalized_dd", normalized_dd},
+                {"lat_dd", coord.lat_dd},
+                {"lon_dd", coord.lon_dd},
+                {"format", std::string(coord.format)},
+                {"is_valid", coord.is_valid},
+                {"label", coord.label.empty() ? std::string("\xD0\x9D\xD0\xB5\xD1\x82") : std::string(coord.label)},   // Нет
+                {"sentence_context", std::move(context)}
+            });
+        }
+        return response.dump(4);
+    }
+
+    // Поиск контекста и метки из analyze_geo_text до перехода на geo::DocumentIndex
+    /**
+     * @brief Извлекает предложение, содержащее совпадение, обрезает до 200 символов.
+     */
+    static std::string find_sentence_context(const std::string& text, size_t pos, size_t length) {
+        // 1. Находим начало предложения
+        size_t sentence_start = 0;
+        // Ищем назад разделители предложений: .?! за которыми следует пробел или перенос строки
+        for (size_t i = pos; i-- > 0; ) {
+            if (i < text.size() - 1 && (text[i] == '.' || text[i] == '?' || text[i] == '!') && std::isspace(text[i+1])) {
+                sentence_start = i + 2; // Переходим после разделителя и пробела
+                break;
+            }
+            if (text[i] == '\n') {
+                 sentence_start = i + 1; // Начинаем с новой строки
+                 break;
+            }
+        }
+
+        // 2. Находим конец предложения
+        size_t sentence_end = text.find_first_of(".?!", pos + length);
+        if (sentence_end == std::string::npos) {
+            sentence_end = text.length();
+        } else {
+            sentence_end++; // Включаем знак препинания
+        }
+
+
+        std::string sentence = text.substr(sentence_start, sentence_end - sentence_start);
+
+        // 3. Удаляем ведущие/конечные пробелы/переносы строки
+        size_t first = sentence.find_first_not_of(" \t\n\r");
+        size_t last = sentence.find_last_not_of(" \t\n\r");
+        if (first == std::string::npos) return ""; 
+        sentence = sentence.substr(first, (last - first + 1));
+
+        // 4. Обрезка до 200 символов
+        if (sentence.length() > 200) {
+            sentence = sentence.substr(0, 197) + "...";
+        }
+
+        return sentence;
+    }
+
+    /**
+     * @brief Извлекает потенциальную метку/название из текста перед совпадением.
+     *
+     * Ищет ключевые слова или слова с заглавной буквы перед двоеточием, тире или непосредственно перед координатой.
+     */
+    static std::string find_label(const std::string& text, size_t pos) {
+        size_t max_lookback = 40;
+        size_t start = (pos > max_lookback) ? pos - max_lookback : 0;
+        std::string lookback_text = text.substr(start, pos - start);
+
+        // Паттерн для поиска слов (включая русские и латинские), предшествующих двоеточию или тире.
+        // Ищем с конца, чтобы найти ближайший заголовок
+        std::regex label_regex(R"(([^.,;!?\n\r]{1,15}\s*(?:[.:-]\s*)?[\s\S]*))", std::regex::icase);
+        std::smatch match;
+
+        std::string potential_label;
+
+        // Ищем последние несколько слов
+        if (std::regex_search(lookback_text, match, label_regex)) {
+            potential_label = match[0].str();
+            std::reverse(potential_label.begin(), potential_label.end()); // Обращаем обратно
+
+            // Обрезаем, чтобы удалить все до первого не-пробельного символа с конца (игнорируя разделитель)
+            size_t last_space = potential_label.find_last_not_of(" \t\n\r.:-");
+            if (last_space != std::string::npos) {
+                potential_label = potential_label.substr(0, last_space + 1);
+            }
+
+            // Выбираем только слова, которые могут быть метками (начинаются с заглавной буквы или являются ключевыми)
+            std::stringstream ss(potential_label);
+            std::string word, result_label;
+            std::vector<std::string> keywords = {"Точка", "Мыс", "Вершина", "Цель", "Point"};
+            while (ss >> word) {
+                std::string upper_word = word;
+                if (!upper_word.empty()) upper_word[0] = std::toupper(static_cast<unsigned char>(upper_word[0]));
+
+                bool is_keyword = std::any_of(keywords.begin(), keywords.end(), [&](const std::string& kw){
+                    return upper_word.find(kw) == 0;
+                });
+
+                if (!word.empty() && (std::isupper(static_cast<unsigned char>(word[0])) || is_keyword)) {
+                    result_label += word + " ";
+                }
+            }
+            if (!result_label.empty()) {
+                result_label.pop_back();
+                return result_label;
+            }
+        }
+
+        return "";
+    }
+}
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    double elapsed_ms(Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    // Строка результата: stage name=value ... time_ms=... mb_per_sec=...
+    class Result
+    {
+    public:
+        explicit Result(std::string stage) { out_ << std::left << std::setw(10) << stage; }
+
+        template <typename T>
+        Result& field(const char* name, const T& value) {
+            out_ << ' ' << name << '=' << value;
+            return *this;
+        }
+
+        void print() { std::cout << out_.str() << std::endl; }
+
+        void print(double time_ms, size_t bytes) {
+            out_ << std::fixed << std::setprecision(2) << " time_ms=" << time_ms
+                << " mb_per_sec=" << (time_ms > 0 ? bytes / (time_ms / 1000.0) / (1024.0 * 1024.0) : 0.0);
+            std::cout << out_.str() << std::endl;
+        }
+
+    private:
+        std::ostringstream out_;
+    };
+
+    std::string read_file(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            throw std::runtime_error("Could not open " + path);
+        }
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        return buffer.str();
+    }
+
+    // Лучшее время из runs прогонов
+    template <typename Finder>
+    void run(const char* impl, const std::string& text, size_t runs, Finder finder) {
+        double best = 0.0;
+        size_t found = 0;
+        for (size_t i = 0; i < runs; ++i) {
+            auto start = Clock::now();
+            found = finder(text);
+            const double ms = elapsed_ms(start);
+            best = i == 0 ? ms : std::min(best, ms);
+        }
+        Result("extract").field("impl", impl).field("bytes", text.size()).field("found", found).print(best, text.size());
+    }
+}
+
+int main(int argc, char** argv) {
+    CLI::App app{ "geo_bench - coordinate extraction benchmark" };
+
+    std::vector<std::string> data_files{ "data/text1.txt", "data/text2.txt" };
+    size_t scale = 100;
+    size_t runs = 3;
+    size_t threads = 0;
+    bool skip_regex = false;
+
+    app.add_option("--data", data_files, "Input texts (default data/text1.txt data/text2.txt)");
+    app.add_option("--scale", scale, "Copies of the inputs in one document (default 100)")->check(CLI::PositiveNumber);
+    app.add_option("--runs", runs, "Runs per implementation, the best time is reported (default 3)")->check(CLI::PositiveNumber);
+    app.add_option("--threads", threads, "Threads for the parallel analysis (default 0 = all cores)");
+    app.add_flag("--skip-regex", skip_regex, "Do not run the std::regex implementation (slow on large documents)");
+
+    try {
+        app.parse(argc, argv);
+    }
+    catch (const CLI::ParseError& e) {
+        return app.exit(e);
+    }
+
+    try {
+        // Найденное в каждом исходном тексте - для сравнения полноты
+        std::string document;
+        for (const auto& path : data_files) {
+            const std::string text = read_file(path);
+            Result("source")
+                .field("file", path)
+                .field("bytes", text.size())
+                .field("regex_found", skip_regex ? 0 : legacy::find_coordinates(text))
+                .field("scanner_found", geo::scan_coordinates(text).size())
+                .print();
+            document += text;
+            document += '\n';
+        }
+
+        std::string scaled;
+        scaled.reserve(document.size() * scale);
+        for (size_t i = 0; i < scale; ++i) {
+            scaled += document;
+        }
+
+        if (!skip_regex) {
+            run("regex", scaled, runs, [](const std::string& text) { return legacy::find_coordinates(text); });
+        }
+        run("scanner", scaled, runs, [](const std::string& text) { return geo::scan_coordinates(text).size(); });
+
+        // Контекст и метки для найденных пар: просмотр текста на каждую пару против индекса документа
+        const auto matches = geo::scan_coordinates(scaled);
+        for (bool use_index : { false, true }) {
+            double best = 0.0;
+            size_t labeled = 0;
+            for (size_t i = 0; i < runs; ++i) {
+                labeled = 0;
+                auto start = Clock::now();
+                if (use_index) {
+                    const geo::DocumentIndex index(scaled);
+                    for (const auto& match : matches) {
+                        index.sentence(match.begin, match.end - match.begin);
+                        labeled += !index.label(match.begin).empty();
+                    }
+                }
+                else {
+                    for (const auto& match : matches) {
+                        legacy::find_sentence_context(scaled, match.begin, match.end - match.begin);
+                        labeled += !legacy::find_label(scaled, match.begin).empty();
+                    }
+                }
+                const double ms = elapsed_ms(start);
+                best = i == 0 ? ms : std::min(best, ms);
+            }
+            Result("context")
+                .field("impl", use_index ? "index" : "rescan")
+                .field("matches", matches.size())
+                .field("labeled", labeled)
+                .print(best, scaled.size());
+        }
+
+        // Полный анализ (поиск, контекст, метки, JSON): в одном потоке и на пуле по отрезкам
+        geo::WorkerPool pool(threads);
+        for (geo::WorkerPool* analysis_pool : { static_cast<geo::WorkerPool*>(nullptr), &pool }) {
+            double best = 0.0;
+            size_t found = 0;
+            for (size_t i = 0; i < runs; ++i) {
+                auto start = Clock::now();
+                found = geo::analyze_geo_text(scaled, analysis_pool).coordinates.size();
+                const double ms = elapsed_ms(start);
+                best = i == 0 ? ms : std::min(best, ms);
+            }
+            Result("analyze")
+                .field("impl", analysis_pool ? "parallel" : "serial")
+                .field("threads", analysis_pool ? pool.size() : 1)
+                .field("found", found)
+                .print(best, scaled.size());
+        }
+
+        // Приём тела /analyze: DOM и копия поля "text" против однопроходного извлечения.
+        // В "escaped" строки разделены \n, в "plain" escape-последовательностей нет и текст не копируется
+        std::string plain = scaled;
+        for (char& c : plain) {
+            if (static_cast<unsigned char>(c) < 0x20 || c == '"' || c == '\\') {
+                c = ' ';
+            }
+        }
+        for (const auto& [body_kind, text] : { std::pair{ "escaped", &scaled }, std::pair{ "plain", &plain } }) {
+            const std::string body = nlohmann::json{ {"text", *text} }.dump();
+            for (const char* impl : { "dom", "extract" }) {
+                const std::string_view name(impl);
+                double best = 0.0;
+                size_t bytes = 0;
+                for (size_t i = 0; i < runs; ++i) {
+                    auto start = Clock::now();
+                    if (name == "dom") {
+                        const nlohmann::json request = nlohmann::json::parse(body);
+                        const std::string copy = request["text"].get<std::string>();
+                        bytes = copy.size();
+                    }
+                    else {
+                        std::string unescaped;
+                        bytes = geo::extract_text_field(body, unescaped).value_or(std::string_view()).size();
+                    }
+                    const double ms = elapsed_ms(start);
+                    best = i == 0 ? ms : std::min(best, ms);
+                }
+                Result("intake")
+                    .field("body", body_kind)
+                    .field("impl", impl)
+                    .field("text_bytes", bytes)
+                    .print(best, body.size());
+            }
+        }
+
+        // Сборка ответа: DOM с отступами против записи в буфер (с отступами и компактно)
+        const geo::GeoAnalysis analysis = geo::analyze_geo_text(scaled);
+        for (const char* impl : { "dom", "writer_pretty", "writer" }) {
+            const std::string_view name(impl);
+            double best = 0.0;
+            size_t bytes = 0;
+            for (size_t i = 0; i < runs; ++i) {
+                auto start = Clock::now();
+                std::string body;
+                if (name == "dom") {
+                    body = legacy::to_json_dom(analysis);
+                }
+                else {
+                    const bool pretty = name == "writer_pretty";
+                    body.reserve(geo::estimate_json_size(analysis, pretty));
+                    geo::JsonWriter writer(body, pretty);
+                    geo::write_analysis_json(writer, analysis);
+                }
+                const double ms = elapsed_ms(start);
+                best = i == 0 ? ms : std::min(best, ms);
+                bytes = body.size();
+            }
+            Result("serialize")
+                .field("impl", impl)
+                .field("coordinates", analysis.coordinates.size())
+                .field("bytes", bytes)
+                .print(best, bytes);
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -10,6 +10,7 @@ class ExampleRecipe(ConanFile):
         self.requires("crowcpp-crow/1.2.1")
         self.requires("nlohmann_json/3.11.2")
         self.requires("cli11/2.3.2")
+        self.requires("zlib/1.3.1")
 
     def layout(self):
         cmake_layout(self)
\ No newline at end of file
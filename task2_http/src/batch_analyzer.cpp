@@ -0,0 +1,140 @@
+#include "batch_analyzer.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "geo_analyzer.hpp"
+
+namespace geo
+{
+    namespace {
+        using Clock = std::chrono::steady_clock;
+
+        // Задач на поток: запас на неравномерность текстов при малом числе задач
+        constexpr std::size_t kRangesPerWorker = 4;
+
+        // Общее состояние пакета; живёт, пока его держит хотя бы одна задача или вызывающий поток
+        struct BatchState {
+            std::vector<std::string> documents;
+            std::vector<std::string> results;     ///< Ответ каждого документа в JSON
+            Clock::time_point deadline;
+            bool has_deadline = false;
+            bool pretty = false;
+            std::atomic<bool> cancelled{ false };
+            std::atomic<std::size_t> analyzed{ 0 };
+
+            std::mutex mutex;
+            std::condition_variable done;
+            std::size_t ranges_left = 0;    ///< Под mutex
+            std::string error;              ///< Под mutex, первая ошибка анализа
+        };
+
+        void analyze_range(BatchState& state, std::size_t begin, std::size_t end) {
+            try {
+                for (std::size_t i = begin; i < end; ++i) {
+                    if (state.cancelled.load(std::memory_order_relaxed)
+                        || (state.has_deadline && Clock::now() >= state.deadline)) {
+                        state.cancelled.store(true, std::memory_order_relaxed);
+                        break;
+                    }
+                    const GeoAnalysis analysis = analyze_geo_text(state.documents[i]);
+                    std::string& out = state.results[i];
+                    out.reserve(estimate_json_size(analysis, state.pretty));
+                    JsonWriter writer(out, state.pretty, 1);
+                    write_analysis_json(writer, analysis);
+                    state.analyzed.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            catch (const std::exception& e) {
+                state.cancelled.store(true, std::memory_order_relaxed);
+                std::lock_guard<std::mutex> lock(state.mutex);
+                if (state.error.empty()) {
+                    state.error = e.what();
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(state.mutex);
+            if (--state.ranges_left == 0) {
+                state.done.notify_all();
+            }
+        }
+    }
+
+    BatchResult analyze_batch(WorkerPool& pool, std::vector<std::string> documents,
+        std::chrono::milliseconds time_budget, bool pretty) {
+        BatchResult result;
+        if (documents.empty()) {
+            result.completed = true;
+            result.json = "[]";
+            return result;
+        }
+
+        auto state = std::make_shared<BatchState>();
+        state->documents = std::move(documents);
+        state->results.resize(state->documents.size());
+        state->has_deadline = time_budget.count() > 0;
+        state->pretty = pretty;
+        state->deadline = Clock::now() + time_budget;
+
+        // Границы диапазонов по накопленному размеру текстов
+        std::size_t total_bytes = 0;
+        for (const auto& document : state->documents) {
+            total_bytes += document.size() + 1;
+        }
+        const std::size_t range_count = std::min(state->documents.size(), pool.size() * kRangesPerWorker);
+        const std::size_t target_bytes = total_bytes / range_count + 1;
+        std::vector<std::pair<std::size_t, std::size_t>> ranges;
+        ranges.reserve(range_count);
+        std::size_t begin = 0, bytes = 0;
+        for (std::size_t i = 0; i < state->documents.size(); ++i) {
+            bytes += state->documents[i].size() + 1;
+            if (bytes >= target_bytes || i + 1 == state->documents.size()) {
+                ranges.emplace_back(begin, i + 1);
+                begin = i + 1;
+                bytes = 0;
+            }
+        }
+
+        state->ranges_left = ranges.size();
+        for (const auto& [first, last] : ranges) {
+            pool.submit([state, first = first, last = last] { analyze_range(*state, first, last); });
+        }
+
+        std::unique_lock<std::mutex> lock(state->mutex);
+        const auto finished = [&] { return state->ranges_left == 0; };
+        const bool in_time = state->has_deadline ? state->done.wait_until(lock, state->deadline, finished)
+            : (state->done.wait(lock, finished), true);
+        result.analyzed = state->analyzed.load(std::memory_order_relaxed);
+
+        if (!in_time || state->cancelled.load(std::memory_order_relaxed)) {
+            state->cancelled.store(true, std::memory_order_relaxed);
+            result.error = state->error;
+            result.timed_out = result.error.empty();
+            return result;
+        }
+
+        // Все задачи завершены - результаты больше никто не трогает. Части пишутся с глубины 1,
+        // запятые и отступы между ними - здесь
+        std::size_t size = 2;
+        for (const auto& part : state->results) {
+            size += part.size() + 6;
+        }
+        result.json.reserve(size);
+        result.json += '[';
+        for (std::size_t i = 0; i < state->results.size(); ++i) {
+            if (i > 0) {
+                result.json += ',';
+            }
+            if (pretty) {
+                result.json += "\n    ";
+            }
+            result.json += state->results[i];
+        }
+        result.json += pretty ? "\n]" : "]";
+        result.completed = true;
+        return result;
+    }
+}
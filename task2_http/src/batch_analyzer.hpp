@@ -0,0 +1,44 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "worker_pool.hpp"
+
+namespace geo
+{
+    /**
+     * @brief Ограничения пакетного анализа (POST /analyze/batch).
+     */
+    struct BatchOptions {
+        std::size_t max_documents = 10000;                  ///< Наибольшее число документов в пакете
+        std::size_t max_bytes = 64 * 1024 * 1024;           ///< Наибольший суммарный размер текстов
+        std::chrono::milliseconds time_budget{ 30000 };     ///< Время на весь пакет; 0 - без ограничения
+    };
+
+    /**
+     * @brief Результат пакета: при completed - JSON-массив ответов /analyze в порядке документов.
+     */
+    struct BatchResult {
+        bool completed = false;         ///< false - бюджет времени исчерпан или анализ документа завершился ошибкой
+        bool timed_out = false;         ///< Бюджет времени исчерпан
+        std::size_t analyzed = 0;       ///< Документов, проанализированных к моменту ответа
+        std::string error;              ///< Текст исключения, если анализ документа завершился ошибкой
+        std::string json;               ///< Массив ответов, если completed
+    };
+
+    /**
+     * @brief Анализирует документы на пуле потоков.
+     *
+     * Документы делятся на непрерывные диапазоны примерно равного размера в байтах (несколько на поток),
+     * чтобы тысячи коротких текстов не превращались в тысячи задач. Задачи владеют документами
+     * через общее состояние, поэтому по истечении бюджета функция возвращается сразу:
+     * ещё не начатые документы пропускаются, начатые дорабатывают в фоне и результат отбрасывается.
+     * Каждый ответ сериализуется в своей задаче; массив собирается из готовых частей.
+     *
+     * @param pretty Отступы в ответе, как у /analyze?pretty=1.
+     */
+    BatchResult analyze_batch(WorkerPool& pool, std::vector<std::string> documents,
+        std::chrono::milliseconds time_budget, bool pretty = false);
+}
@@ -0,0 +1,673 @@
+#include "coord_scanner.hpp"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <optional>
+
+#include "utf8.hpp"
+
+namespace geo
+{
+    namespace {
+        enum class Hemisphere { None, North, South, East, West };
+        // Порядок совпадает с номером части: градусы - первая, минуты - вторая, секунды - третья
+        enum class Unit { None, Degree, Minute, Second };
+
+        constexpr std::size_t kMaxPieces = 3;
+        // Цифр в одной части числа; длиннее - не координата (телефоны, номера документов)
+        constexpr std::size_t kMaxDigits = 12;
+        constexpr std::size_t kNpos = std::string_view::npos;
+
+        bool is_latitude(Hemisphere h) { return h == Hemisphere::North || h == Hemisphere::South; }
+        bool is_longitude(Hemisphere h) { return h == Hemisphere::East || h == Hemisphere::West; }
+
+        using utf8::CodePoint;
+        using utf8::decode;
+        using utf8::fold;
+        using utf8::is_digit;
+        using utf8::is_letter;
+        using utf8::is_space;
+
+        /**
+         * @brief Однопроходный разбор текста: позиции - смещения в байтах, символы декодируются по месту.
+         */
+        class Scanner
+        {
+        public:
+            explicit Scanner(std::string_view text) : text_(text) {}
+
+            std::vector<CoordinateMatch> run() {
+                std::vector<CoordinateMatch> matches;
+                std::size_t p = 0;
+                while (p < text_.size()) {
+                    p = step(p, matches);
+                }
+                return matches;
+            }
+
+            /**
+             * @brief Один шаг поиска с позиции p: найденная пара добавляется в matches, возвращается следующая позиция.
+             *
+             * Состояние сканера - только позиция, поэтому два прохода, побывавшие в одной позиции, дальше совпадают.
+             * Пара, найденная на шаге с позиции p, начинается не раньше p.
+             */
+            std::size_t step(std::size_t p, std::vector<CoordinateMatch>& matches) const {
+                if (!could_start(p)) {
+                    return p + decode_at(p).length;
+                }
+                const auto first = parse_component(p);
+                if (!first) {
+                    return skip_token(p);
+                }
+                if (!first->has_signal()) {
+                    return first->end;
+                }
+                const std::size_t separator = separator_end(first->end);
+                const auto second = separator == kNpos ? std::nullopt : parse_component(separator);
+                if (!second || !second->has_signal()) {
+                    return first->end;
+                }
+
+                CoordinateMatch match;
+                switch (make_match(*first, *second, match)) {
+                case PairResult::Accepted:
+                    matches.push_back(match);
+                    return second->end;
+                case PairResult::OutOfRange:
+                    // Пара распознана, но значения недопустимы: её числа не участвуют в других парах
+                    return second->end;
+                case PairResult::Mismatch:
+                default:
+                    // Полушария не сходятся: второй компонент может начинать следующую пару
+                    return second->begin;
+                }
+            }
+
+        private:
+            struct Piece {
+                double value = 0.0;
+                Unit unit = Unit::None;
+                bool fraction = false;
+                std::size_t int_begin = 0;
+                std::size_t int_digits = 0;
+            };
+
+            struct Component {
+                std::size_t begin = 0;
+                std::size_t end = 0;
+                Hemisphere hemisphere = Hemisphere::None;
+                bool negative = false;
+                std::array<Piece, kMaxPieces> pieces{};
+                std::size_t count = 0;
+
+                // Слитная запись ГГММ[СС]: одно целое число без единицы, не короче 4 цифр
+                bool packed() const {
+                    return count == 1 && pieces[0].unit == Unit::None && pieces[0].int_digits >= 4;
+                }
+
+                // Голое целое ("15 августа", "№1") координатой не считается
+                bool has_signal() const {
+                    return hemisphere != Hemisphere::None || count > 1 || pieces[0].fraction
+                        || pieces[0].unit != Unit::None || packed();
+                }
+            };
+
+            struct HemisphereToken {
+                Hemisphere hemisphere = Hemisphere::None;
+                std::size_t end = 0;
+                bool letter = false;        // одиночная буква N, С, ...
+                bool abbreviation = false;  // с.ш., в.д., ...
+            };
+
+            enum class PairResult { Accepted, Mismatch, OutOfRange };
+
+            // --- Символы ---
+
+            CodePoint decode_at(std::size_t pos) const { return decode(text_, pos); }
+
+            char32_t decode_before(std::size_t pos) const { return utf8::decode_before(text_, pos); }
+
+            bool letter_at(std::size_t pos) const { return pos < text_.size() && is_letter(decode_at(pos).value); }
+            bool digit_at(std::size_t pos) const { return pos < text_.size() && is_digit(text_[pos]); }
+            bool word_start(std::size_t pos) const { return !is_letter(decode_before(pos)); }
+
+            std::size_t skip_spaces(std::size_t pos) const {
+                while (pos < text_.size()) {
+                    const CodePoint cp = decode_at(pos);
+                    if (!is_space(cp.value)) {
+                        break;
+                    }
+                    pos += cp.length;
+                }
+                return pos;
+            }
+
+            std::size_t skip_letters(std::size_t pos) const {
+                while (pos < text_.size()) {
+                    const CodePoint cp = decode_at(pos);
+                    if (!is_letter(cp.value)) {
+                        break;
+                    }
+                    pos += cp.length;
+                }
+                return pos;
+            }
+
+            // Сравнение без учёта регистра с основой слова (строчные буквы в UTF-8); end - позиция за основой
+            bool match_stem(std::size_t pos, std::string_view stem, std::size_t& end) const {
+                return utf8::starts_with_folded(text_, pos, stem, end);
+            }
+
+            // Знак: '-', '+' или U+2212, сразу за ним цифра; возвращает длину знака
+            std::size_t sign_length(std::size_t pos) const {
+                if (pos >= text_.size()) {
+                    return 0;
+                }
+                std::size_t length = 0;
+                if (text_[pos] == '-' || text_[pos] == '+') {
+                    length = 1;
+                }
+                else if (text_.compare(pos, 3, "\xE2\x88\x92") == 0) {
+                    length = 3;
+                }
+                return length > 0 && digit_at(pos + length) ? length : 0;
+            }
+
+            // Дальше начинается число (со знаком или без)
+            bool number_follows(std::size_t pos) const { return digit_at(pos) || sign_length(pos) > 0; }
+
+            // --- Лексемы ---
+
+            bool could_start(std::size_t pos) const {
+                const char c = text_[pos];
+                if (is_digit(c) || c == '-' || c == '+' || c == '\xE2') {
+                    // Число или знак - не продолжение слова или другого числа ("TZ-04", "x15")
+                    const char32_t before = decode_before(pos);
+                    return (is_digit(c) || sign_length(pos) > 0) && !is_letter(before) && !is_digit(before);
+                }
+                // Полушарие: N S E W или кириллическая буква в начале слова
+                return (c == 'N' || c == 'S' || c == 'E' || c == 'W' || c == '\xD0' || c == '\xD1') && word_start(pos);
+            }
+
+            // Позиция, с которой продолжить поиск после неудачи: число или слово пропускаются целиком
+            std::size_t skip_token(std::size_t pos) const {
+                if (digit_at(pos)) {
+                    while (digit_at(pos) || ((text_[pos] == '.' || text_[pos] == ',') && digit_at(pos + 1))) {
+                        ++pos;
+                    }
+                    return pos;
+                }
+                if (letter_at(pos)) {
+                    return skip_letters(pos);
+                }
+                return pos + decode_at(pos).length;
+            }
+
+            std::optional<HemisphereToken> hemisphere_at(std::size_t pos) const {
+                if (pos >= text_.size() || !word_start(pos)) {
+                    return std::nullopt;
+                }
+                const CodePoint first = decode_at(pos);
+
+                // Сокращения с.ш., ю.ш., в.д., з.д. (точка в конце необязательна)
+                const char32_t initial = fold(first.value);
+                Hemisphere abbreviated = Hemisphere::None;
+                char32_t axis_letter = 0;
+                switch (initial) {
+                case 0x441: abbreviated = Hemisphere::North; axis_letter = 0x448; break;    // с.ш.
+                case 0x44E: abbreviated = Hemisphere::South; axis_letter = 0x448; break;    // ю.ш.
+                case 0x432: abbreviated = Hemisphere::East; axis_letter = 0x434; break;     // в.д.
+                case 0x437: abbreviated = Hemisphere::West; axis_letter = 0x434; break;     // з.д.
+                default: break;
+                }
+                if (abbreviated != Hemisphere::None && pos + first.length < text_.size() && text_[pos + first.length] == '.') {
+                    std::size_t q = skip_spaces(pos + first.length + 1);
+                    if (q < text_.size()) {
+                        const CodePoint axis = decode_at(q);
+                        if (fold(axis.value) == axis_letter && !letter_at(q + axis.length)) {
+                            q += axis.length;
+                            if (q < text_.size() && text_[q] == '.') {
+                                ++q;
+                            }
+                            return HemisphereToken{ abbreviated, q, false, true };
+                        }
+                    }
+                }
+
+                // Словами: "северная широта", "северной широты", "западная долгота", ...
+                static constexpr struct {
+                    std::string_view side;
+                    std::string_view axis;
+                    Hemisphere hemisphere;
+                } kWords[] = {
+                    { "\xD1\x81\xD0\xB5\xD0\xB2\xD0\xB5\xD1\x80\xD0\xBD", "\xD1\x88\xD0\xB8\xD1\x80\xD0\xBE\xD1\x82", Hemisphere::North },        // северн, широт
+                    { "\xD1\x8E\xD0\xB6\xD0\xBD", "\xD1\x88\xD0\xB8\xD1\x80\xD0\xBE\xD1\x82", Hemisphere::South },                                // южн, широт
+                    { "\xD0\xB2\xD0\xBE\xD1\x81\xD1\x82\xD0\xBE\xD1\x87\xD0\xBD", "\xD0\xB4\xD0\xBE\xD0\xBB\xD0\xB3\xD0\xBE\xD1\x82", Hemisphere::East },  // восточн, долгот
+                    { "\xD0\xB7\xD0\xB0\xD0\xBF\xD0\xB0\xD0\xB4\xD0\xBD", "\xD0\xB4\xD0\xBE\xD0\xBB\xD0\xB3\xD0\xBE\xD1\x82", Hemisphere::West },      // западн, долгот
+                };
+                for (const auto& word : kWords) {
+                    std::size_t end = 0;
+                    if (!match_stem(pos, word.side, end)) {
+                        continue;
+                    }
+                    end = skip_letters(end);
+                    const std::size_t axis_start = skip_spaces(end);
+                    if (axis_start > end && match_stem(axis_start, word.axis, end)) {
+                        return HemisphereToken{ word.hemisphere, skip_letters(end), false, false };
+                    }
+                    return std::nullopt;
+                }
+
+                // Одиночная буква: N S E W, С Ю В З
+                Hemisphere letter = Hemisphere::None;
+                switch (first.value) {
+                case 'N': case 0x421: letter = Hemisphere::North; break;
+                case 'S': case 0x42E: letter = Hemisphere::South; break;
+                case 'E': case 0x412: letter = Hemisphere::East; break;
+                case 'W': case 0x417: letter = Hemisphere::West; break;
+                default: break;
+                }
+                if (letter != Hemisphere::None && !letter_at(pos + first.length)) {
+                    return HemisphereToken{ letter, pos + first.length, true, false };
+                }
+                return std::nullopt;
+            }
+
+            // Число: цифры и необязательная дробная часть через точку или запятую
+            bool number_at(std::size_t pos, Piece& piece, std::size_t& end) const {
+                std::size_t q = pos;
+                while (digit_at(q)) {
+                    ++q;
+                }
+                const std::size_t int_digits = q - pos;
+                if (int_digits == 0 || int_digits > kMaxDigits) {
+                    return false;
+                }
+                bool fraction = false;
+                if (q + 1 < text_.size() && (text_[q] == '.' || text_[q] == ',') && digit_at(q + 1)) {
+                    std::size_t r = q + 1;
+                    while (digit_at(r)) {
+                        ++r;
+                    }
+                    if (r - q - 1 > kMaxDigits) {
+                        return false;
+                    }
+                    fraction = true;
+                    q = r;
+                }
+
+                std::array<char, 2 * kMaxDigits + 2> buffer{};
+                std::size_t length = q - pos;
+                text_.copy(buffer.data(), length, pos);
+                if (fraction) {
+                    buffer[int_digits] = '.';
+                }
+                double value = 0.0;
+                if (std::from_chars(buffer.data(), buffer.data() + length, value).ec != std::errc{}) {
+                    return false;
+                }
+                piece = Piece{ value, Unit::None, fraction, pos, int_digits };
+                end = q;
+                return true;
+            }
+
+            // Единица сразу после числа: ° º ' ′ ’ '' ″ " ”
+            Unit symbol_unit_at(std::size_t pos, std::size_t& end) const {
+                if (pos >= text_.size()) {
+                    return Unit::None;
+                }
+                const CodePoint cp = decode_at(pos);
+                end = pos + cp.length;
+                switch (cp.value) {
+                case 0xB0: case 0xBA:
+                    return Unit::Degree;
+                case '\'': case 0x2032: case 0x2019:
+                    // Два штриха подряд - секунды (81°12'18''N)
+                    if (end < text_.size() && decode_at(end).value == cp.value) {
+                        end += cp.length;
+                        return Unit::Second;
+                    }
+                    return Unit::Minute;
+                case '"': case 0x2033: case 0x201D:
+                    return Unit::Second;
+                default:
+                    return Unit::None;
+                }
+            }
+
+            // Единица словом после пробела: градус(а, ов), минут(а, ы), секунд(а, ы), а также град., мин., сек.
+            Unit word_unit_at(std::size_t pos, std::size_t& end) const {
+                static constexpr struct {
+                    std::string_view stem;
+                    Unit unit;
+                } kUnits[] = {
+                    { "\xD0\xB3\xD1\x80\xD0\xB0\xD0\xB4", Unit::Degree },   // град
+                    { "\xD0\xBC\xD0\xB8\xD0\xBD", Unit::Minute },           // мин
+                    { "\xD1\x81\xD0\xB5\xD0\xBA", Unit::Second },           // сек
+                };
+                if (!word_start(pos)) {
+                    return Unit::None;
+                }
+                for (const auto& unit : kUnits) {
+                    if (match_stem(pos, unit.stem, end)) {
+                        end = skip_letters(end);
+                        return unit.unit;
+                    }
+                }
+                return Unit::None;
+            }
+
+            // Единица после числа: символ вплотную или слово через пробел; word - единица словом
+            Unit unit_after(std::size_t pos, std::size_t& end, bool& word) const {
+                word = false;
+                Unit unit = symbol_unit_at(pos, end);
+                if (unit == Unit::None) {
+                    const std::size_t w = skip_spaces(pos);
+                    if (w > pos) {
+                        unit = word_unit_at(w, end);
+                        word = unit != Unit::None;
+                    }
+                }
+                return unit;
+            }
+
+            /**
+             * @brief Компонент с позиции pos. lookahead - можно ли заглянуть в следующий компонент,
+             * чтобы решить, чья буква полушария стоит между ними (вложенный разбор не заглядывает дальше).
+             */
+            std::optional<Component> parse_component(std::size_t pos, bool lookahead = true) const {
+                Component c;
+                c.begin = pos;
+                std::size_t q = pos;
+
+                if (!digit_at(q) && sign_length(q) == 0) {
+                    const auto prefix = hemisphere_at(q);
+                    if (!prefix) {
+                        return std::nullopt;
+                    }
+                    // Буква - вплотную к числу (N80.4551), сокращение или слова - через пробел
+                    q = prefix->letter ? prefix->end : skip_spaces(prefix->end);
+                    if (!number_follows(q)) {
+                        return std::nullopt;
+                    }
+                    c.hemisphere = prefix->hemisphere;
+                }
+                if (const std::size_t sign = sign_length(q)) {
+                    c.negative = text_[q] == '-' || sign == 3;
+                    q += sign;
+                }
+
+                for (;;) {
+                    Piece& piece = c.pieces[c.count];
+                    std::size_t after = 0;
+                    if (!number_at(q, piece, after)) {
+                        return std::nullopt;
+                    }
+                    ++c.count;
+                    q = after;
+                    const auto role = static_cast<Unit>(c.count);
+
+                    std::size_t unit_end = 0;
+                    bool word_unit = false;
+                    const Unit unit = unit_after(q, unit_end, word_unit);
+                    if (unit == Unit::None) {
+                        // Дефис между градусами и минутами: 80-12.5N, 104-59.10W
+                        if (!piece.fraction && c.count < kMaxPieces && q < text_.size() && text_[q] == '-' && digit_at(q + 1)) {
+                            piece.unit = role;
+                            q += 1;
+                            continue;
+                        }
+                        break;
+                    }
+                    if (unit != role) {
+                        return std::nullopt;
+                    }
+                    piece.unit = unit;
+                    q = unit_end;
+                    if (piece.fraction || c.count == kMaxPieces) {
+                        break;
+                    }
+
+                    // Следующая часть вплотную (81°12'18'') принимается всегда, через пробел
+                    // (и союз "и" после единицы словом) - только с единицей следующего порядка
+                    std::size_t next = skip_spaces(q);
+                    const bool spaced = next > q;
+                    if (spaced && word_unit) {
+                        std::size_t conjunction_end = 0;
+                        if (match_stem(next, "\xD0\xB8", conjunction_end) && !letter_at(conjunction_end)) {   // и
+                            const std::size_t after_conjunction = skip_spaces(conjunction_end);
+                            if (after_conjunction > conjunction_end) {
+                                next = after_conjunction;
+                            }
+                        }
+                    }
+                    Piece lookahead;
+                    std::size_t lookahead_end = 0;
+                    if (!number_at(next, lookahead, lookahead_end)) {
+                        break;
+                    }
+                    if (spaced) {
+                        bool unused = false;
+                        if (unit_after(lookahead_end, unit_end, unused) != static_cast<Unit>(c.count + 1)) {
+                            break;
+                        }
+                    }
+                    q = next;
+                }
+                c.end = q;
+
+                if (c.hemisphere == Hemisphere::None) {
+                    if (const auto suffix = hemisphere_at(q)) {
+                        // Вплотную к числу или единице: 80.9001N, 58°44.95'В
+                        c.hemisphere = suffix->hemisphere;
+                        c.end = suffix->end;
+                    }
+                    else if (const std::size_t w = skip_spaces(q); w > q) {
+                        // Через пробел: сокращение всегда, буква N/S/E/W или слова - если за ними
+                        // не начинается следующий компонент (иначе это приставка следующего)
+                        // или у следующего есть собственный суффикс, см. spaced_suffix
+                        const auto spaced = hemisphere_at(w);
+                        if (spaced && (spaced->abbreviation
+                            || ((!spaced->letter || static_cast<unsigned char>(text_[w]) < 0x80) && spaced_suffix(spaced->end, lookahead)))) {
+                            c.hemisphere = spaced->hemisphere;
+                            c.end = spaced->end;
+                        }
+                    }
+                }
+
+                // Число, слитое со словом ("15км", "2023г"), координатой не является
+                if (c.end == q && letter_at(q)) {
+                    return std::nullopt;
+                }
+                return c;
+            }
+
+            /**
+             * @brief Полушарие через пробел, заканчивающееся в end, - суффикс предыдущего числа.
+             *
+             * Да, если дальше не начинается число. Если начинается, но у следующего компонента есть
+             * собственный суффикс ("55.75 N 37.61 E", "51°12.32' S 32°34.43' E"), полушарие тоже
+             * относится к предыдущему: приставкой оно оставило бы предыдущий компонент без полушария,
+             * и пара не сложилась бы.
+             */
+            bool spaced_suffix(std::size_t end, bool lookahead) const {
+                const std::size_t next = skip_spaces(end);
+                if (!number_follows(next)) {
+                    return true;
+                }
+                if (!lookahead) {
+                    return false;
+                }
+                const auto following = parse_component(next, false);
+                return following && following->hemisphere != Hemisphere::None;
+            }
+
+            // Разделитель компонентов: пробелы, знак , ; / или союз "и" / "или"; kNpos - разделителя нет
+            std::size_t separator_end(std::size_t pos) const {
+                std::size_t q = skip_spaces(pos);
+                const bool spaced = q > pos;
+                if (q < text_.size() && (text_[q] == ',' || text_[q] == ';' || text_[q] == '/')) {
+                    return skip_spaces(q + 1);
+                }
+                if (!spaced) {
+                    return kNpos;
+                }
+                for (std::string_view conjunction : { std::string_view("\xD0\xB8\xD0\xBB\xD0\xB8"), std::string_view("\xD0\xB8") }) {   // или, и
+                    std::size_t end = 0;
+                    if (match_stem(q, conjunction, end) && !letter_at(end)) {
+                        const std::size_t after = skip_spaces(end);
+                        if (after > end) {
+                            return after;
+                        }
+                    }
+                }
+                return q;
+            }
+
+            int digits_value(std::size_t pos, std::size_t count) const {
+                int value = 0;
+                for (std::size_t i = 0; i < count; ++i) {
+                    value = value * 10 + (text_[pos + i] - '0');
+                }
+                return value;
+            }
+
+            // Десятичные градусы компонента; false - запись или значение недопустимы
+            bool to_degrees(const Component& c, bool latitude, double& result, Notation& notation) const {
+                double degrees = 0.0, minutes = 0.0, seconds = 0.0;
+                if (c.packed()) {
+                    // Градусы - 2 цифры у широты и 3 у долготы, далее ММ, ММм (десятые минуты) или ММСС
+                    const Piece& piece = c.pieces[0];
+                    const std::size_t degree_digits = latitude ? 2 : 3;
+                    if (piece.int_digits <= degree_digits) {
+                        return false;
+                    }
+                    const std::size_t rest = piece.int_digits - degree_digits;
+                    const double fraction = piece.value - std::trunc(piece.value);
+                    const std::size_t p = piece.int_begin;
+                    degrees = digits_value(p, degree_digits);
+                    if (rest == 2) {
+                        minutes = digits_value(p + degree_digits, 2) + fraction;
+                        notation = Notation::DDM;
+                    }
+                    else if (rest == 3 && !piece.fraction) {
+                        minutes = digits_value(p + degree_digits, 2) + digits_value(p + degree_digits + 2, 1) / 10.0;
+                        notation = Notation::DDM;
+                    }
+                    else if (rest == 4) {
+                        minutes = digits_value(p + degree_digits, 2);
+                        seconds = digits_value(p + degree_digits + 2, 2) + fraction;
+                        notation = Notation::DMS;
+                    }
+                    else {
+                        return false;
+                    }
+                }
+                else {
+                    degrees = c.pieces[0].value;
+                    minutes = c.count > 1 ? c.pieces[1].value : 0.0;
+                    seconds = c.count > 2 ? c.pieces[2].value : 0.0;
+                    notation = c.count == 1 ? Notation::DD : c.count == 2 ? Notation::DDM : Notation::DMS;
+                }
+                if (minutes >= 60.0 || seconds >= 60.0) {
+                    return false;
+                }
+
+                double value = degrees + minutes / 60.0 + seconds / 3600.0;
+                // Полушарие важнее знака: S/W - отрицательное значение, N/E - положительное
+                if (c.hemisphere == Hemisphere::South || c.hemisphere == Hemisphere::West) {
+                    value = -value;
+                }
+                else if (c.hemisphere == Hemisphere::None && c.negative) {
+                    value = -value;
+                }
+                result = value;
+                return std::abs(value) <= (latitude ? 90.0 : 180.0);
+            }
+
+            PairResult make_match(const Component& first, const Component& second, CoordinateMatch& match) const {
+                if ((first.hemisphere == Hemisphere::None) != (second.hemisphere == Hemisphere::None)) {
+                    return PairResult::Mismatch;
+                }
+                const Component* lat = &first;
+                const Component* lon = &second;
+                if (is_longitude(first.hemisphere) && is_latitude(second.hemisphere)) {
+                    std::swap(lat, lon);
+                }
+                if (lat->hemisphere != Hemisphere::None && (!is_latitude(lat->hemisphere) || !is_longitude(lon->hemisphere))) {
+                    return PairResult::Mismatch;
+                }
+                if (!to_degrees(*lat, true, match.lat_dd, match.lat_notation)
+                    || !to_degrees(*lon, false, match.lon_dd, match.lon_notation)) {
+                    return PairResult::OutOfRange;
+                }
+                match.begin = first.begin;
+                match.end = second.end;
+                return PairResult::Accepted;
+            }
+
+            std::string_view text_;
+        };
+    }
+
+    const char* notation_name(Notation notation) {
+        switch (notation) {
+        case Notation::DDM: return "DDM";
+        case Notation::DMS: return "DMS";
+        default: return "DD";
+        }
+    }
+
+    std::string_view pair_format(Notation lat, Notation lon) {
+        static constexpr std::string_view kNames[3][3] = {
+            { "DD", "Mixed(DD/DDM)", "Mixed(DD/DMS)" },
+            { "Mixed(DDM/DD)", "DDM", "Mixed(DDM/DMS)" },
+            { "Mixed(DMS/DD)", "Mixed(DMS/DDM)", "DMS" },
+        };
+        return kNames[static_cast<int>(lat)][static_cast<int>(lon)];
+    }
+
+    std::vector<CoordinateMatch> scan_coordinates(std::string_view text) {
+        return Scanner(text).run();
+    }
+
+    SegmentScan scan_segment(std::string_view text, std::size_t begin, std::size_t end) {
+        SegmentScan segment;
+        segment.begin = begin;
+        segment.end = end;
+        const Scanner scanner(text);
+        std::size_t p = begin;
+        while (p < end) {
+            if (p < begin + SegmentScan::kTraceBytes) {
+                segment.trace.push_back(p);
+            }
+            p = scanner.step(p, segment.matches);
+        }
+        segment.exit = p;
+        return segment;
+    }
+
+    std::vector<CoordinateMatch> join_segments(std::string_view text, const std::vector<SegmentScan>& segments) {
+        std::vector<CoordinateMatch> matches;
+        const Scanner scanner(text);
+        std::size_t p = 0;
+        for (const SegmentScan& segment : segments) {
+            // Последовательный проход от позиции, где закончился предыдущий отрезок, до совпадения с проходом отрезка;
+            // за пределами следа отрезка совпадение не найти - тогда отрезок проходится последовательно целиком
+            while (p < segment.end && !std::binary_search(segment.trace.begin(), segment.trace.end(), p)) {
+                p = scanner.step(p, matches);
+            }
+            if (p < segment.end) {
+                const auto first = std::lower_bound(segment.matches.begin(), segment.matches.end(), p,
+                    [](const CoordinateMatch& match, std::size_t pos) { return match.begin < pos; });
+                matches.insert(matches.end(), first, segment.matches.end());
+                p = segment.exit;
+            }
+        }
+        while (p < text.size()) {
+            p = scanner.step(p, matches);
+        }
+        return matches;
+    }
+}
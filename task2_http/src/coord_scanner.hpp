@@ -0,0 +1,83 @@
+#pragma once
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace geo
+{
+    /**
+     * @brief Запись компонента координаты.
+     */
+    enum class Notation {
+        DD,     ///< Десятичные градусы: 55.7558, N80.4551, 39.7500°
+        DDM,    ///< Градусы и десятичные минуты: 81°10.50'N, 80-12.5N, 5401N
+        DMS,    ///< Градусы, минуты, секунды: 76°00′00″ с.ш., 394430N
+    };
+
+    /**
+     * @brief Название записи для JSON-ответа ("DD", "DDM", "DMS").
+     */
+    const char* notation_name(Notation notation);
+
+    /**
+     * @brief Формат пары: "DD", "DMS", ... или "Mixed(DD/DDM)", если записи широты и долготы различаются.
+     * Строка статическая, память не выделяется.
+     */
+    std::string_view pair_format(Notation lat, Notation lon);
+
+    /**
+     * @brief Найденная пара координат (широта, долгота).
+     */
+    struct CoordinateMatch {
+        std::size_t begin = 0;              ///< Смещение первого байта пары в тексте
+        std::size_t end = 0;                ///< Смещение за последним байтом пары
+        double lat_dd = 0.0;                ///< Широта в десятичных градусах, [-90, 90]
+        double lon_dd = 0.0;                ///< Долгота в десятичных градусах, [-180, 180]
+        Notation lat_notation = Notation::DD;
+        Notation lon_notation = Notation::DD;
+    };
+
+    /**
+     * @brief Находит пары координат в тексте UTF-8 за один линейный проход.
+     *
+     * Компонент пары - число (знак, десятичная точка или запятая) или группа "градусы минуты секунды"
+     * с разделителями ° ′ ″ ' '' " ’ ”, словами "градусов/минут/секунд" или дефисом (80-12.5N),
+     * а также слитная запись ГГММ[СС] (394430N, 1045930W). Полушарие задаётся буквой N/S/E/W/С/Ю/В/З
+     * до или после числа, сокращением с.ш./ю.ш./в.д./з.д. или словами "северная широта" и т. п.
+     * Компоненты разделяются пробелами и переносами строк, знаками , ; / или словами "и", "или".
+     *
+     * Пара принимается, если у обоих компонентов есть признак координаты (дробная часть, единица,
+     * полушарие или слитная запись), полушарие указано у обоих или ни у одного, минуты и секунды
+     * меньше 60, а значения в допустимых границах. Пара "долгота широта" (E.. N..) переставляется.
+     * Числа разбираются std::from_chars, память выделяется только под результат.
+     */
+    std::vector<CoordinateMatch> scan_coordinates(std::string_view text);
+
+    /**
+     * @brief Результат поиска на отрезке текста - часть параллельного поиска.
+     */
+    struct SegmentScan {
+        static constexpr std::size_t kTraceBytes = 4096;    ///< Длина начала отрезка, позиции сканера в котором запоминаются
+
+        std::size_t begin = 0;
+        std::size_t end = 0;
+        std::vector<CoordinateMatch> matches;   ///< Пары, найденные от begin; последняя может заканчиваться за end
+        std::vector<std::size_t> trace;         ///< Позиции сканера в [begin, begin + kTraceBytes) по возрастанию
+        std::size_t exit = 0;                   ///< Первая позиция сканера не раньше end
+    };
+
+    /**
+     * @brief Ищет пары, начиная с begin, пока позиция сканера меньше end.
+     * Сканер видит весь текст, поэтому пара на границе отрезков находится целиком.
+     */
+    SegmentScan scan_segment(std::string_view text, std::size_t begin, std::size_t end);
+
+    /**
+     * @brief Сшивает результаты смежных отрезков, покрывающих текст с начала, в результат scan_coordinates(text).
+     *
+     * Если последовательный проход перепрыгнул начало отрезка (пара через границу), он продолжается
+     * от места прыжка, пока не попадёт в позицию из следа отрезка; дальше проходы совпадают,
+     * и используются пары отрезка. Если совпадения нет, отрезок проходится последовательно.
+     */
+    std::vector<CoordinateMatch> join_segments(std::string_view text, const std::vector<SegmentScan>& segments);
+}
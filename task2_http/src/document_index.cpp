@@ -0,0 +1,190 @@
+#include "document_index.hpp"
+#include <algorithm>
+
+#include "utf8.hpp"
+
+namespace geo
+{
+    namespace {
+        // Основы ключевых слов метки (строчные, UTF-8)
+        constexpr std::string_view kLabelKeywords[] = {
+            "\xD1\x82\xD0\xBE\xD1\x87\xD0\xBA",                     // точк(а, и, е)
+            "\xD0\xBC\xD1\x8B\xD1\x81",                             // мыс
+            "\xD0\xB2\xD0\xB5\xD1\x80\xD1\x88\xD0\xB8\xD0\xBD",     // вершин(а, ы)
+            "\xD1\x86\xD0\xB5\xD0\xBB\xD1\x8C",                     // цель
+            "point",
+        };
+
+        bool is_clause_delimiter(char32_t c) {
+            return c == '.' || c == ',' || c == ';' || c == ':' || c == '!' || c == '?' || c == '\n';
+        }
+
+        bool is_sentence_terminator(char32_t c) { return c == '.' || c == '?' || c == '!'; }
+
+        // Позиция pos (> 0) - граница разреза: см. split_point_after
+        bool is_split_point(std::string_view text, std::size_t pos) {
+            const char c = text[pos - 1];
+            if (c == '\n') {
+                // Все пробелы перед переводом строки (пустые строки, NBSP) пропускаются
+                const char32_t before = utf8::decode_before(text, utf8::trim_back(text, 0, pos - 1));
+                return before != ':' && before != '-' && before != 0x2013 && before != 0x2014;
+            }
+            if (c == '.' || c == '?' || c == '!') {
+                if (pos >= text.size()) {
+                    return false;
+                }
+                const char next = text[pos];
+                return next == ' ' || next == '\t' || next == '\r' || next == '\n';
+            }
+            return false;
+        }
+    }
+
+    std::size_t split_point_after(std::string_view text, std::size_t pos) {
+        for (std::size_t i = std::max<std::size_t>(pos, 1); i < text.size(); ++i) {
+            if (is_split_point(text, i)) {
+                return i;
+            }
+        }
+        return text.size();
+    }
+
+    std::size_t split_point_before(std::string_view text, std::size_t pos) {
+        for (std::size_t i = std::min(pos, text.size()); i > 0; --i) {
+            if (is_split_point(text, i)) {
+                return i;
+            }
+        }
+        return 0;
+    }
+
+    DocumentIndex::DocumentIndex(std::string_view text) : text_(text) {
+        // Примерно одно слово на 7 байт текста
+        words_.reserve(text.size() / 7 + 1);
+
+        std::size_t word_begin = 0;
+        bool in_word = false;
+        std::size_t pos = 0;
+        while (pos < text.size()) {
+            const utf8::CodePoint cp = utf8::decode(text, pos);
+            const std::size_t next = pos + cp.length;
+            if (utf8::is_space(cp.value)) {
+                if (in_word) {
+                    words_.push_back({ word_begin, pos, is_name_like(word_begin, pos) });
+                    in_word = false;
+                }
+                if (cp.value == '\n') {
+                    sentence_ends_.push_back(pos);
+                    clause_starts_.push_back(next);
+                }
+            }
+            else {
+                if (!in_word) {
+                    word_begin = pos;
+                    in_word = true;
+                }
+                // Конец предложения - знак перед пробелом или концом текста ("80.9001N" - не конец)
+                if (is_sentence_terminator(cp.value) && (next == text.size() || utf8::is_space(utf8::decode(text, next).value))) {
+                    sentence_ends_.push_back(next);
+                }
+                if (is_clause_delimiter(cp.value)) {
+                    clause_starts_.push_back(next);
+                }
+            }
+            pos = next;
+        }
+        if (in_word) {
+            words_.push_back({ word_begin, text.size(), is_name_like(word_begin, text.size()) });
+        }
+    }
+
+    bool DocumentIndex::is_name_like(std::size_t begin, std::size_t end) const {
+        // Открывающие скобки и кавычки перед словом пропускаются: "(Северная", "«Дуб"
+        std::size_t pos = begin;
+        while (pos < end) {
+            const utf8::CodePoint cp = utf8::decode(text_, pos);
+            if (utf8::is_letter(cp.value)) {
+                break;
+            }
+            if (cp.value != '(' && cp.value != '"' && cp.value != 0xAB && cp.value != 0x201C) {
+                return false;
+            }
+            pos += cp.length;
+        }
+        if (pos >= end) {
+            return false;
+        }
+        if (utf8::is_upper(utf8::decode(text_, pos).value)) {
+            return true;
+        }
+        std::size_t stem_end = 0;
+        return std::any_of(std::begin(kLabelKeywords), std::end(kLabelKeywords), [&](std::string_view keyword) {
+            return utf8::starts_with_folded(text_.substr(0, end), pos, keyword, stem_end);
+        });
+    }
+
+    std::size_t DocumentIndex::advance_chars(std::size_t pos, std::size_t end, std::size_t count) const {
+        for (; count > 0 && pos < end; --count) {
+            pos += utf8::decode(text_, pos).length;
+        }
+        return std::min(pos, end);
+    }
+
+    DocumentIndex::Sentence DocumentIndex::sentence(std::size_t pos, std::size_t length) const {
+        // Начало - последний конец предложения не дальше pos, конец - первый не ближе конца фрагмента
+        const auto after_start = std::upper_bound(sentence_ends_.begin(), sentence_ends_.end(), pos);
+        std::size_t begin = after_start == sentence_ends_.begin() ? 0 : *(after_start - 1);
+        const auto stop = std::lower_bound(after_start, sentence_ends_.end(), pos + length);
+        std::size_t end = stop == sentence_ends_.end() ? text_.size() : *stop;
+
+        while (begin < end && utf8::is_space(utf8::decode(text_, begin).value)) {
+            begin += utf8::decode(text_, begin).length;
+        }
+        end = utf8::trim_back(text_, begin, end);
+
+        // Символы считаются не дальше предела, длинное предложение не просматривается целиком
+        if (advance_chars(begin, end, kMaxContextChars) < end) {
+            // Обрезка по границе символа, место для "..." оставляется
+            const std::size_t cut = advance_chars(begin, end, kMaxContextChars - 3);
+            return { text_.substr(begin, cut - begin), true };
+        }
+        return { text_.substr(begin, end - begin), false };
+    }
+
+    std::string_view DocumentIndex::label(std::size_t pos) const {
+        // Разделитель перед координатой: ":" или тире, отбитое пробелами
+        const std::size_t q = utf8::trim_back(text_, 0, pos);
+        const char32_t separator = utf8::decode_before(text_, q);
+        std::size_t label_end = 0;
+        if (separator == ':') {
+            label_end = q - 1;
+        }
+        else if (separator == '-' || separator == 0x2013 || separator == 0x2014) {
+            const std::size_t dash = q - (separator == '-' ? 1 : 3);
+            if (!utf8::is_space(utf8::decode_before(text_, dash))) {
+                return {};
+            }
+            label_end = dash;
+        }
+        else {
+            return {};
+        }
+        label_end = utf8::trim_back(text_, 0, label_end);
+
+        // Фраза от последнего разделителя фраз до метки; слова перебираются от начала фразы,
+        // но не дальше kMaxLabelChars символов (не более 4 байт каждый) от метки
+        const auto clause = std::upper_bound(clause_starts_.begin(), clause_starts_.end(), label_end);
+        std::size_t first = clause == clause_starts_.begin() ? 0 : *(clause - 1);
+        if (label_end > 4 * kMaxLabelChars) {
+            first = std::max(first, label_end - 4 * kMaxLabelChars);
+        }
+        auto word = std::lower_bound(words_.begin(), words_.end(), first,
+            [](const Word& w, std::size_t offset) { return w.begin < offset; });
+        for (; word != words_.end() && word->begin < label_end; ++word) {
+            if (word->name_like && advance_chars(word->begin, label_end, kMaxLabelChars) == label_end) {
+                return text_.substr(word->begin, label_end - word->begin);
+            }
+        }
+        return {};
+    }
+}
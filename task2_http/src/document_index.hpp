@@ -0,0 +1,78 @@
+#pragma once
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace geo
+{
+    /**
+     * @brief Индекс документа для поиска контекста и метки координат.
+     *
+     * Строится один раз за линейный проход: концы предложений, начала фраз и таблица слов.
+     * Запросы - двоичный поиск по этим таблицам, результаты - string_view в исходный текст,
+     * поэтому текст должен жить дольше индекса.
+     */
+    class DocumentIndex
+    {
+    public:
+        static constexpr std::size_t kMaxContextChars = 200;
+        static constexpr std::size_t kMaxLabelChars = 40;
+
+        /**
+         * @brief Предложение-контекст без пробелов по краям.
+         */
+        struct Sentence {
+            std::string_view text;
+            bool truncated = false;     ///< Обрезано до kMaxContextChars - 3 символов, при выводе дописывается "..."
+        };
+
+        explicit DocumentIndex(std::string_view text);
+
+        /**
+         * @brief Предложение, содержащее фрагмент [pos, pos + length).
+         *
+         * Предложение заканчивается знаком . ? ! перед пробелом или концом текста либо переводом строки.
+         */
+        Sentence sentence(std::size_t pos, std::size_t length) const;
+
+        /**
+         * @brief Метка координаты, начинающейся в pos; пустая строка - метки нет.
+         *
+         * Меткой считается фраза перед координатой, отделённая от неё двоеточием или тире
+         * ("Point Alpha: ...", "точка B - ..."), начиная с первого слова с заглавной буквы
+         * или ключевого слова (точка, мыс, вершина, цель, point) и не длиннее kMaxLabelChars символов.
+         */
+        std::string_view label(std::size_t pos) const;
+
+    private:
+        struct Word {
+            std::size_t begin = 0;
+            std::size_t end = 0;
+            bool name_like = false;     ///< С заглавной буквы или ключевое слово
+        };
+
+        bool is_name_like(std::size_t begin, std::size_t end) const;
+        /// Позиция через count символов от pos, не дальше end
+        std::size_t advance_chars(std::size_t pos, std::size_t end, std::size_t count) const;
+
+        std::string_view text_;
+        std::vector<std::size_t> sentence_ends_;    ///< Позиция за знаком конца предложения или позиция перевода строки
+        std::vector<std::size_t> clause_starts_;    ///< Позиция за разделителем фраз . , ; : ! ? или переводом строки
+        std::vector<Word> words_;                   ///< Слова (непробельные последовательности) по возрастанию begin
+    };
+
+    /**
+     * @brief Первая граница разреза текста не раньше pos; text.size(), если границы нет.
+     *
+     * Граница - позиция за знаком . ? ! перед пробелом или за переводом строки, кроме строки,
+     * заканчивающейся двоеточием или тире ("Point Alpha:" перед координатой на следующей строке).
+     * Индекс части текста, начинающейся с границы, даёт для координат в ней те же предложения и метки,
+     * что и индекс всего текста.
+     */
+    std::size_t split_point_after(std::string_view text, std::size_t pos);
+
+    /**
+     * @brief Последняя граница разреза текста не позже pos; 0, если границы нет.
+     */
+    std::size_t split_point_before(std::string_view text, std::size_t pos);
+}
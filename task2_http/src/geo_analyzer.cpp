@@ -0,0 +1,178 @@
+#include "geo_analyzer.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <functional>
+#include <optional>
+#include <vector>
+
+#include "coord_scanner.hpp"
+#include "document_index.hpp"
+
+namespace geo
+{
+    // --- Вспомогательные функции для анализа ---
+
+    /**
+     * @brief Сравнивает две координаты с учетом погрешности (для замкнутого полигона).
+     */
+    static bool coords_match(const Coordinate& c1, const Coordinate& c2, double tolerance = 0.0001) {
+        return std::abs(c1.lat_dd - c2.lat_dd) < tolerance &&
+               std::abs(c1.lon_dd - c2.lon_dd) < tolerance;
+    }
+
+    Coordinate make_coordinate(std::string_view text, const DocumentIndex& index, const CoordinateMatch& match) {
+        Coordinate coord;
+        coord.lat_dd = match.lat_dd;
+        coord.lon_dd = match.lon_dd;
+        coord.is_valid = true;
+        coord.original_text = text.substr(match.begin, match.end - match.begin);
+        coord.format = pair_format(match.lat_notation, match.lon_notation);
+
+        const DocumentIndex::Sentence sentence = index.sentence(match.begin, match.end - match.begin);
+        coord.sentence_context = sentence.text;
+        coord.context_truncated = sentence.truncated;
+        coord.label = index.label(match.begin);
+        return coord;
+    }
+
+    std::string_view classify_coordinates(std::size_t count, const Coordinate& first, const Coordinate& last) {
+        if (count <= 1) {
+            return "Одиночные точки";
+        }
+        // Полигон - первая и последняя точки совпадают, и точек >= 3
+        if (count >= 3 && coords_match(first, last)) {
+            return "Замкнутый полигон";
+        }
+        return "Линия";
+    }
+
+    // --- Формирование JSON ---
+
+    void write_coordinate_json(JsonWriter& writer, const Coordinate& coord) {
+        // DD для вывода с 4 знаками после запятой: "55.7558N 37.6173E"
+        char normalized[64];
+        char* end = std::to_chars(normalized, normalized + 30, std::abs(coord.lat_dd), std::chars_format::fixed, 4).ptr;
+        *end++ = coord.lat_dd >= 0 ? 'N' : 'S';
+        *end++ = ' ';
+        end = std::to_chars(end, normalized + sizeof(normalized) - 1, std::abs(coord.lon_dd), std::chars_format::fixed, 4).ptr;
+        *end++ = coord.lon_dd >= 0 ? 'E' : 'W';
+
+        writer.begin_object();
+        writer.key("format").value(coord.format);
+        writer.key("is_valid").value(coord.is_valid);
+        writer.key("label").value(coord.label.empty() ? std::string_view("Нет") : coord.label);
+        writer.key("lat_dd").value(coord.lat_dd);
+        writer.key("lon_dd").value(coord.lon_dd);
+        writer.key("normalized_dd").value(std::string_view(normalized, end - normalized));
+        writer.key("original").value(coord.original_text);
+        writer.key("sentence_context").value_parts(coord.sentence_context, coord.context_truncated ? "..." : "");
+        writer.end_object();
+    }
+
+    void write_analysis_json(JsonWriter& writer, const GeoAnalysis& analysis) {
+        writer.begin_object();
+        writer.key("coordinate_type").value(analysis.coordinate_type);
+        writer.key("coordinates").begin_array();
+        for (const Coordinate& coord : analysis.coordinates) {
+            write_coordinate_json(writer, coord);
+        }
+        writer.end_array();
+        writer.key("total_found").value(analysis.coordinates.size());
+        writer.end_object();
+    }
+
+    std::size_t estimate_json_size(const GeoAnalysis& analysis, bool pretty) {
+        // Постоянная часть объекта координаты (ключи, числа, отступы) и строки, которые копируются как есть
+        const std::size_t per_coordinate = pretty ? 360 : 220;
+        std::size_t size = 128;
+        for (const Coordinate& coord : analysis.coordinates) {
+            size += per_coordinate + coord.original_text.size() + coord.label.size() + coord.sentence_context.size();
+        }
+        return size;
+    }
+
+    // --- Параллельный поиск ---
+
+    /**
+     * @brief Поиск координат на пуле: сканирование и индексы отрезков строятся параллельно, пары сшиваются
+     * последовательно (join_segments), контекст и метки ищутся по индексу отрезка, в котором лежит пара.
+     */
+    static std::vector<Coordinate> find_coordinates_parallel(std::string_view text, WorkerPool& pool, size_t segment_count) {
+        std::vector<size_t> starts{ 0 };
+        for (size_t k = 1; k < segment_count; ++k) {
+            // Граница разреза (split_point_after): индекс отрезка даёт те же предложения и метки, что и индекс всего текста
+            const size_t boundary = split_point_after(text, std::max(starts.back(), text.size() / segment_count * k) + 1);
+            if (boundary >= text.size()) {
+                break;
+            }
+            starts.push_back(boundary);
+        }
+        const auto segment_end = [&](size_t i) { return i + 1 < starts.size() ? starts[i + 1] : text.size(); };
+
+        std::vector<SegmentScan> scans(starts.size());
+        std::vector<std::optional<DocumentIndex>> indexes(starts.size());
+        std::vector<std::function<void()>> tasks;
+        for (size_t i = 0; i < starts.size(); ++i) {
+            tasks.push_back([&, i] {
+                scans[i] = scan_segment(text, starts[i], segment_end(i));
+                indexes[i].emplace(text.substr(starts[i], segment_end(i) - starts[i]));
+            });
+        }
+        pool.run_and_wait(std::move(tasks));
+
+        const std::vector<CoordinateMatch> matches = join_segments(text, scans);
+        std::vector<Coordinate> found_coords;
+        found_coords.reserve(matches.size());
+        for (const CoordinateMatch& match : matches) {
+            const size_t first = std::upper_bound(starts.begin(), starts.end(), match.begin) - starts.begin() - 1;
+            CoordinateMatch local = match;
+            local.begin -= starts[first];
+            local.end -= starts[first];
+            if (match.end <= segment_end(first)) {
+                const std::string_view segment = text.substr(starts[first], segment_end(first) - starts[first]);
+                found_coords.push_back(make_coordinate(segment, *indexes[first], local));
+                continue;
+            }
+            // Пара через границу отрезков (перенос строки между широтой и долготой): индекс по объединению отрезков
+            const size_t last = std::upper_bound(starts.begin(), starts.end(), match.end - 1) - starts.begin() - 1;
+            const std::string_view joined = text.substr(starts[first], segment_end(last) - starts[first]);
+            found_coords.push_back(make_coordinate(joined, DocumentIndex(joined), local));
+        }
+        return found_coords;
+    }
+
+    // --- Основной обработчик логики ---
+
+    /**
+     * @brief Обрабатывает POST-запрос с текстом, извлекает и классифицирует координаты.
+     * @param text Исходный текст для анализа.
+     * @return Координаты и тип набора.
+     */
+    GeoAnalysis analyze_geo_text(std::string_view text, WorkerPool* pool) {
+        GeoAnalysis analysis;
+        std::vector<Coordinate>& found_coords = analysis.coordinates;
+        const size_t segment_count = pool ? std::min(pool->size(), text.size() / kMinSegmentBytes) : 1;
+        if (text.size() >= kParallelMinBytes && segment_count > 1) {
+            found_coords = find_coordinates_parallel(text, *pool, segment_count);
+        }
+        else {
+            // Пары находит однопроходный сканер; он же проверяет границы значений
+            const std::vector<CoordinateMatch> matches = scan_coordinates(text);
+            found_coords.reserve(matches.size());
+
+            // Контекст и метки ищутся по индексу документа, построенному один раз
+            const DocumentIndex index(text);
+            for (const CoordinateMatch& match : matches) {
+                found_coords.push_back(make_coordinate(text, index, match));
+            }
+        }
+
+        // --- Классификация набора координат ---
+
+        const size_t count = found_coords.size();
+        analysis.coordinate_type = count == 0 ? classify_coordinates(0, Coordinate{}, Coordinate{})
+            : classify_coordinates(count, found_coords.front(), found_coords.back());
+        return analysis;
+    }
+}
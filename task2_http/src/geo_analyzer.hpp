@@ -0,0 +1,82 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "coord_scanner.hpp"
+#include "document_index.hpp"
+#include "json_writer.hpp"
+#include "worker_pool.hpp"
+
+namespace geo
+{
+    /**
+     * @brief Структура для хранения данных об одной найденной координате.
+     *
+     * Строковые поля - представления исходного текста (или статических строк) и действительны,
+     * пока жив текст; копируются только при формировании JSON.
+     */
+    struct Coordinate {
+        std::string_view original_text;     ///< Исходный текст координаты
+        double lat_dd = 0.0;                ///< Широта в десятичных градусах (Decimal Degrees)
+        double lon_dd = 0.0;                ///< Долгота в десятичных градусах (Decimal Degrees)
+        std::string_view format;            ///< Определенный формат (DD, DMS, DDM, Mixed)
+        bool is_valid = false;              ///< Флаг валидности (в пределах [-90, 90] и [-180, 180])
+        std::string_view label;             ///< Выделенная метка/название
+        std::string_view sentence_context;  ///< Предложение-контекст (до 200 символов)
+        bool context_truncated = false;     ///< Контекст обрезан, при выводе дописывается "..."
+    };
+
+    /**
+     * @brief Собирает координату из найденной пары: исходный текст, формат, метка и контекст по индексу документа.
+     * Поля-представления ссылаются на text.
+     */
+    Coordinate make_coordinate(std::string_view text, const DocumentIndex& index, const CoordinateMatch& match);
+
+    /**
+     * @brief Тип набора координат ("Одиночные точки", "Линия", "Замкнутый полигон")
+     * по числу точек и совпадению первой и последней. Строка статическая.
+     */
+    std::string_view classify_coordinates(std::size_t count, const Coordinate& first, const Coordinate& last);
+
+    /**
+     * @brief Результат анализа текста; координаты ссылаются на текст.
+     */
+    struct GeoAnalysis {
+        std::string_view coordinate_type;   ///< Одиночные точки, линия или замкнутый полигон
+        std::vector<Coordinate> coordinates;
+    };
+
+    /**
+     * @brief Пишет объект одной координаты - элемент массива "coordinates" ответа.
+     */
+    void write_coordinate_json(JsonWriter& writer, const Coordinate& coord);
+
+    /**
+     * @brief Пишет ответ /analyze: {"coordinate_type", "coordinates", "total_found"}.
+     * Ключи - в порядке, в котором их выводил nlohmann::json (по алфавиту).
+     */
+    void write_analysis_json(JsonWriter& writer, const GeoAnalysis& analysis);
+
+    /**
+     * @brief Примерный размер JSON ответа в байтах - для резервирования буфера.
+     */
+    std::size_t estimate_json_size(const GeoAnalysis& analysis, bool pretty);
+
+    /**
+     * @brief Находит координаты в тексте и классифицирует набор (одиночные точки, линия, замкнутый полигон).
+     *
+     * С пулом текст от kParallelMinBytes делится по границам предложений на отрезки, которые сканируются
+     * и индексируются параллельно; результат совпадает с последовательным анализом.
+     * Пул нельзя передавать из задачи, выполняемой на нём же.
+     *
+     * @param text Исходный текст для анализа (UTF-8).
+     * @param pool Пул для параллельного анализа больших текстов; nullptr - анализ в вызывающем потоке.
+     * @return Найденные координаты и тип набора; ответ JSON пишет write_analysis_json.
+     */
+    GeoAnalysis analyze_geo_text(std::string_view text, WorkerPool* pool = nullptr);
+
+    inline constexpr std::size_t kParallelMinBytes = 1024 * 1024;      ///< Меньшие тексты анализируются последовательно
+    inline constexpr std::size_t kMinSegmentBytes = 256 * 1024;        ///< Наименьший отрезок параллельного анализа
+}
@@ -0,0 +1,230 @@
+#include "json_writer.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+
+#include "utf8.hpp"
+
+namespace geo
+{
+    namespace {
+        // Границы десятичной записи без экспоненты, как в nlohmann::detail::to_chars
+        constexpr int kMinExp = -4;
+        constexpr int kMaxExp = 15;
+
+        constexpr char kHex[] = "0123456789abcdef";
+    }
+
+    void append_json_number(std::string& out, double number) {
+        if (!std::isfinite(number)) {
+            out += "null";
+            return;
+        }
+        if (number == 0.0) {
+            out += std::signbit(number) ? "-0.0" : "0.0";
+            return;
+        }
+        if (number < 0) {
+            out += '-';
+            number = -number;
+        }
+
+        // Кратчайшие цифры и порядок: "d.ddde+XX"
+        char scientific[32];
+        const auto result = std::to_chars(scientific, scientific + sizeof(scientific), number, std::chars_format::scientific);
+        const char* exponent_mark = std::find(scientific, result.ptr, 'e');
+        char digits[20];
+        int k = 0;
+        for (const char* p = scientific; p < exponent_mark; ++p) {
+            if (*p != '.') {
+                digits[k++] = *p;
+            }
+        }
+        int exponent = 0;
+        std::from_chars(exponent_mark + 1 + (exponent_mark[1] == '+'), result.ptr, exponent);
+        const int n = exponent + 1;     // Позиция десятичной точки относительно начала цифр
+
+        if (k <= n && n <= kMaxExp) {
+            // digits[000].0
+            out.append(digits, k);
+            out.append(n - k, '0');
+            out += ".0";
+        }
+        else if (0 < n && n <= kMaxExp) {
+            // dig.its
+            out.append(digits, n);
+            out += '.';
+            out.append(digits + n, k - n);
+        }
+        else if (kMinExp < n && n <= 0) {
+            // 0.[000]digits
+            out += "0.";
+            out.append(-n, '0');
+            out.append(digits, k);
+        }
+        else {
+            // d.igitse+XX
+            out += digits[0];
+            if (k > 1) {
+                out += '.';
+                out.append(digits + 1, k - 1);
+            }
+            const int e = n - 1;
+            out += e < 0 ? "e-" : "e+";
+            const int magnitude = std::abs(e);
+            if (magnitude < 10) {
+                out += '0';
+            }
+            char buffer[8];
+            const auto end = std::to_chars(buffer, buffer + sizeof(buffer), magnitude).ptr;
+            out.append(buffer, end);
+        }
+    }
+
+    JsonWriter::JsonWriter(std::string& out, bool pretty, std::size_t depth)
+        : out_(out), pretty_(pretty), depth_(depth), inline_next_(depth > 0) {
+    }
+
+    void JsonWriter::newline(std::size_t depth) {
+        out_ += '\n';
+        out_.append(depth * 4, ' ');
+    }
+
+    void JsonWriter::before_value() {
+        if (inline_next_) {
+            inline_next_ = false;
+            return;
+        }
+        if (depth_ == 0) {
+            return;
+        }
+        if (!first_) {
+            out_ += ',';
+        }
+        if (pretty_) {
+            newline(depth_);
+        }
+        first_ = false;
+    }
+
+    JsonWriter& JsonWriter::begin_object() {
+        before_value();
+        out_ += '{';
+        ++depth_;
+        first_ = true;
+        return *this;
+    }
+
+    JsonWriter& JsonWriter::end_object() {
+        --depth_;
+        if (pretty_ && !first_) {
+            newline(depth_);
+        }
+        out_ += '}';
+        first_ = false;
+        return *this;
+    }
+
+    JsonWriter& JsonWriter::begin_array() {
+        before_value();
+        out_ += '[';
+        ++depth_;
+        first_ = true;
+        return *this;
+    }
+
+    JsonWriter& JsonWriter::end_array() {
+        --depth_;
+        if (pretty_ && !first_) {
+            newline(depth_);
+        }
+        out_ += ']';
+        first_ = false;
+        return *this;
+    }
+
+    JsonWriter& JsonWriter::key(std::string_view name) {
+        before_value();
+        out_ += '"';
+        append_escaped(name);
+        out_ += pretty_ ? "\": " : "\":";
+        inline_next_ = true;
+        return *this;
+    }
+
+    JsonWriter& JsonWriter::value(std::string_view text) {
+        before_value();
+        out_ += '"';
+        append_escaped(text);
+        out_ += '"';
+        return *this;
+    }
+
+    JsonWriter& JsonWriter::value_parts(std::string_view first, std::string_view second) {
+        before_value();
+        out_ += '"';
+        append_escaped(first);
+        append_escaped(second);
+        out_ += '"';
+        return *this;
+    }
+
+    JsonWriter& JsonWriter::value(double number) {
+        before_value();
+        append_json_number(out_, number);
+        return *this;
+    }
+
+    JsonWriter& JsonWriter::value(std::size_t number) {
+        before_value();
+        char buffer[24];
+        const auto result = std::to_chars(buffer, buffer + sizeof(buffer), number);
+        out_.append(buffer, result.ptr);
+        return *this;
+    }
+
+    JsonWriter& JsonWriter::value(bool flag) {
+        before_value();
+        out_ += flag ? "true" : "false";
+        return *this;
+    }
+
+    void JsonWriter::append_escaped(std::string_view text) {
+        std::size_t run = 0;    // Начало ещё не скопированного участка без экранирования
+        std::size_t pos = 0;
+        while (pos < text.size()) {
+            const auto c = static_cast<unsigned char>(text[pos]);
+            if (c >= 0x80) {
+                const utf8::CodePoint cp = utf8::decode(text, pos);
+                if (cp.value == 0xFFFD && cp.length == 1) {
+                    out_.append(text.data() + run, pos - run);
+                    out_ += "\xEF\xBF\xBD";
+                    run = pos + 1;
+                }
+                pos += cp.length;
+                continue;
+            }
+            if (c >= 0x20 && c != '"' && c != '\\') {
+                ++pos;
+                continue;
+            }
+            out_.append(text.data() + run, pos - run);
+            switch (c) {
+            case '"': out_ += "\\\""; break;
+            case '\\': out_ += "\\\\"; break;
+            case '\b': out_ += "\\b"; break;
+            case '\f': out_ += "\\f"; break;
+            case '\n': out_ += "\\n"; break;
+            case '\r': out_ += "\\r"; break;
+            case '\t': out_ += "\\t"; break;
+            default:
+                out_ += "\\u00";
+                out_ += kHex[c >> 4];
+                out_ += kHex[c & 0x0F];
+                break;
+            }
+            run = ++pos;
+        }
+        out_.append(text.data() + run, pos - run);
+    }
+}
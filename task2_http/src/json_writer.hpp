@@ -0,0 +1,62 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace geo
+{
+    /**
+     * @brief Запись JSON прямо в строку-буфер без промежуточного DOM.
+     *
+     * Вывод совпадает с nlohmann::json::dump(): компактный или с отступом 4 пробела, числа с плавающей
+     * точкой - кратчайшая запись (std::to_chars) в той же форме ("80.0", "0.0001", "1e-05").
+     * Некорректные последовательности UTF-8 в строках заменяются на U+FFFD, а не прерывают вывод.
+     * Порядок ключей задаёт вызывающий код; буфер только дописывается, поэтому его можно заранее
+     * зарезервировать и переиспользовать между ответами.
+     */
+    class JsonWriter
+    {
+    public:
+        /**
+         * @param out Буфер, в конец которого дописывается JSON.
+         * @param pretty Отступы и переводы строк, как у dump(4).
+         * @param depth Начальная глубина вложенности для части, вставляемой в массив вызывающим кодом:
+         *        запятую и перевод строки перед ней пишет он сам.
+         */
+        JsonWriter(std::string& out, bool pretty, std::size_t depth = 0);
+
+        JsonWriter& begin_object();
+        JsonWriter& end_object();
+        JsonWriter& begin_array();
+        JsonWriter& end_array();
+
+        JsonWriter& key(std::string_view name);
+
+        JsonWriter& value(std::string_view text);
+        JsonWriter& value(const char* text) { return value(std::string_view(text)); }
+        JsonWriter& value(double number);
+        JsonWriter& value(std::size_t number);
+        JsonWriter& value(bool flag);
+
+        /**
+         * @brief Строковое значение из нескольких частей без промежуточной строки.
+         */
+        JsonWriter& value_parts(std::string_view first, std::string_view second);
+
+    private:
+        void before_value();
+        void newline(std::size_t depth);
+        void append_escaped(std::string_view text);
+
+        std::string& out_;
+        bool pretty_;
+        std::size_t depth_;
+        bool first_ = true;         ///< В текущем контейнере ещё нет элементов
+        bool inline_next_ = false;  ///< Следующее значение пишется сразу: значение ключа или часть, вставляемая вызывающим
+    };
+
+    /**
+     * @brief Дописывает число в форме nlohmann::json::dump(): кратчайшая запись, ".0" у целых, "null" у NaN и бесконечностей.
+     */
+    void append_json_number(std::string& out, double number);
+}
@@ -1,327 +1,100 @@
+#include <chrono>
+#include <fstream>
 #include <iostream>
+#include <memory>
+#include <optional>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <stop_token>
+#include <thread>
 #include <vector>
-#include <cmath>
-#include <sstream>
-#include <algorithm>
-#include <iomanip>
-#include <regex>
 
 
 #include "crow.h"
 #include <nlohmann/json.hpp>
 #include "CLI/CLI.hpp"
 
-using json = nlohmann::json;
-
-// --- 1. Структуры данных и константы ---
+#include "batch_analyzer.hpp"
+#include "dir_watcher.hpp"
+#include "geo_analyzer.hpp"
+#include "request_text.hpp"
+#include "result_cache.hpp"
+#include "static_assets.hpp"
+#include "stream_analyzer.hpp"
 
-/**
- * @brief Структура для хранения данных об одной найденной координате.
- */
-struct Coordinate {
-    std::string original_text;      ///< Исходный текст координаты
-    double lat_dd = 0.0;            ///< Широта в десятичных градусах (Decimal Degrees)
-    double lon_dd = 0.0;            ///< Долгота в десятичных градусах (Decimal Degrees)
-    std::string format;             ///< Определенный формат (DD, DMS, DDM, Mixed)
-    bool is_valid = false;          ///< Флаг валидности (в пределах [-90, 90] и [-180, 180])
-    std::string label;              ///< Выделенная метка/название
-    std::string sentence_context;   ///< Предложение-контекст (до 200 символов)
-};
-
-// --- 2. Вспомогательные функции для парсинга и анализа ---
+using json = nlohmann::json;
 
 /**
- * @brief Преобразует градусы, минуты, секунды в десятичные градусы.
- * @return Значение в десятичных градусах.
+ * @brief Запрошен ли ответ с отступами: ?pretty, ?pretty=1, ?pretty=true. По умолчанию ответ компактный.
  */
-static double dms_to_dd(double deg, double min, double sec) {
-    return deg + min / 60.0 + sec / 3600.0;
+static bool pretty_requested(const crow::request& req) {
+    const char* pretty = req.url_params.get("pretty");
+    return pretty != nullptr && std::string_view(pretty) != "0" && std::string_view(pretty) != "false";
 }
 
 /**
- * @brief Нормализует строку компонента координаты и извлекает DD.
- *
- * @param geo_str Строка компонента (например, "76°00′00″ с.ш.", "N80.4551").
- * @param is_latitude Флаг, указывающий, является ли это широтой (true) или долготой (false).
- * @param format Ссылка для записи определенного формата.
- * @return Значение в десятичных градусах, 999.0 в случае ошибки/невалидности.
+ * @brief Ответ файлом статического каталога из памяти: gzip-вариант, если клиент его принимает,
+ * и 304 по If-None-Match или, без него, по If-Modified-Since.
  */
-static double normalize_and_validate_component(const std::string& geo_str, bool is_latitude, std::string& format) {
-    std::string s = geo_str;
-    // Заменяем русские запятые на точки и удаляем символы, которые могли быть захвачены
-    std::replace(s.begin(), s.end(), ',', '.');
-
-    // Находим направление (N, S, E, W, С, Ю, В, З)
-    char direction = ' ';
-    std::string clean_val;
-    
-    // Ищем направление и очищаем от знаков препинания и букв
-    for (char c : s) {
-        if (std::isalpha(static_cast<unsigned char>(c))) {
-            char upper_c = std::toupper(static_cast<unsigned char>(c));
-            if (is_latitude) {
-                if (upper_c == 'N' || upper_c == 'S' || upper_c == 'C' || upper_c == 'Ю') {
-                    direction = (direction == ' ') ? upper_c : direction;
-                }
-            } else { // Долгота
-                if (upper_c == 'E' || upper_c == 'W' || upper_c == 'В' || upper_c == 'З') {
-                    direction = (direction == ' ') ? upper_c : direction;
-                }
-            }
-        }
-        if (std::isdigit(c) || c == '.' || c == ' ' || c == '-') {
-            clean_val += c;
-        }
-    }
-
-    // Удаляем лишние пробелы и очищаем от множественных пробелов
-    std::stringstream val_ss(clean_val);
-    std::vector<double> parts;
-    double p;
-    while (val_ss >> p) {
-        parts.push_back(p);
-    }
-
-    double dd = 0.0;
-
-    if (parts.size() == 1) { // Decimal Degrees (DD)
-        dd = parts[0];
-        format = "DD";
-    } else if (parts.size() == 2) { // Degrees Decimal Minutes (DDM) - Deg Min.min
-        if (parts[1] >= 60.0) return 999.0; // Минуты >= 60
-        dd = dms_to_dd(parts[0], parts[1], 0.0);
-        format = "DDM";
-    } else if (parts.size() == 3) { // Degrees Minutes Seconds (DMS) - Deg Min Sec
-        if (parts[1] >= 60.0 || parts[2] >= 60.0) return 999.0; // Минуты/секунды >= 60
-        dd = dms_to_dd(parts[0], parts[1], parts[2]);
-        format = "DMS";
-    } else {
-        return 999.0; // Неизвестный формат
+static crow::response serve_static(const geo::StaticAssets& assets, const crow::request& req, const std::string& path) {
+    const std::shared_ptr<const geo::StaticAsset> asset = assets.find(path);
+    if (!asset) {
+        return crow::response(404, "{\"error\": \"Не найден файл " + path + " в статическом каталоге: " + assets.root() + "\"}");
     }
 
-    // Применяем знак, если есть направление (Юг/Запад -> отрицательное значение)
-    if (direction == 'S' || direction == 'Ю' || direction == 'W' || direction == 'З') {
-        dd = -std::abs(dd);
-    } else {
-        dd = std::abs(dd);
-    }
-
-    // Проверка на валидность (границы)
-    double max_val = is_latitude ? 90.0 : 180.0;
-    if (std::abs(dd) > max_val) {
-        return 999.0; // Недопустимое значение
-    }
-
-    return dd;
-}
-
-/**
- * @brief Извлекает предложение, содержащее совпадение, обрезает до 200 символов.
- */
-static std::string find_sentence_context(const std::string& text, size_t pos, size_t length) {
-    // 1. Находим начало предложения
-    size_t sentence_start = 0;
-    // Ищем назад разделители предложений: .?! за которыми следует пробел или перенос строки
-    for (size_t i = pos; i-- > 0; ) {
-        if (i < text.size() - 1 && (text[i] == '.' || text[i] == '?' || text[i] == '!') && std::isspace(text[i+1])) {
-            sentence_start = i + 2; // Переходим после разделителя и пробела
-            break;
-        }
-        if (text[i] == '\n') {
-             sentence_start = i + 1; // Начинаем с новой строки
-             break;
+    const bool gzip = !asset->gzip.empty() && req.get_header_value("Accept-Encoding").find("gzip") != std::string::npos;
+    const std::string& etag = gzip ? asset->gzip_etag : asset->etag;
+    const std::string& if_none_match = req.get_header_value("If-None-Match");
+    const bool not_modified = if_none_match.empty()
+        ? req.get_header_value("If-Modified-Since") == asset->last_modified
+        : geo::etag_matches(if_none_match, etag);
+
+    crow::response res(not_modified ? 304 : 200);
+    if (!not_modified) {
+        res.body = gzip ? asset->gzip : asset->body;
+        res.set_header("Content-Type", std::string(asset->content_type));
+        if (gzip) {
+            res.set_header("Content-Encoding", "gzip");
         }
     }
-
-    // 2. Находим конец предложения
-    size_t sentence_end = text.find_first_of(".?!", pos + length);
-    if (sentence_end == std::string::npos) {
-        sentence_end = text.length();
-    } else {
-        sentence_end++; // Включаем знак препинания
+    res.set_header("ETag", etag);
+    res.set_header("Last-Modified", asset->last_modified);
+    // Кеш браузера перепроверяет файл при каждом открытии - иначе изменения каталога не видны до истечения срока
+    res.set_header("Cache-Control", "no-cache");
+    if (!asset->gzip.empty()) {
+        res.set_header("Vary", "Accept-Encoding");
     }
-
-
-    std::string sentence = text.substr(sentence_start, sentence_end - sentence_start);
-
-    // 3. Удаляем ведущие/конечные пробелы/переносы строки
-    size_t first = sentence.find_first_not_of(" \t\n\r");
-    size_t last = sentence.find_last_not_of(" \t\n\r");
-    if (first == std::string::npos) return ""; 
-    sentence = sentence.substr(first, (last - first + 1));
-
-    // 4. Обрезка до 200 символов
-    if (sentence.length() > 200) {
-        sentence = sentence.substr(0, 197) + "...";
-    }
-
-    return sentence;
-}
-
-/**
- * @brief Извлекает потенциальную метку/название из текста перед совпадением.
- *
- * Ищет ключевые слова или слова с заглавной буквы перед двоеточием, тире или непосредственно перед координатой.
- */
-static std::string find_label(const std::string& text, size_t pos) {
-    size_t max_lookback = 40;
-    size_t start = (pos > max_lookback) ? pos - max_lookback : 0;
-    std::string lookback_text = text.substr(start, pos - start);
-
-    // Паттерн для поиска слов (включая русские и латинские), предшествующих двоеточию или тире.
-    // Ищем с конца, чтобы найти ближайший заголовок
-    std::regex label_regex(R"(([^.,;!?\n\r]{1,15}\s*(?:[.:-]\s*)?[\s\S]*))", std::regex::icase);
-    std::smatch match;
-
-    std::string potential_label;
-
-    // Ищем последние несколько слов
-    if (std::regex_search(lookback_text, match, label_regex)) {
-        potential_label = match[0].str();
-        std::reverse(potential_label.begin(), potential_label.end()); // Обращаем обратно
-
-        // Обрезаем, чтобы удалить все до первого не-пробельного символа с конца (игнорируя разделитель)
-        size_t last_space = potential_label.find_last_not_of(" \t\n\r.:-");
-        if (last_space != std::string::npos) {
-            potential_label = potential_label.substr(0, last_space + 1);
-        }
-
-        // Выбираем только слова, которые могут быть метками (начинаются с заглавной буквы или являются ключевыми)
-        std::stringstream ss(potential_label);
-        std::string word, result_label;
-        std::vector<std::string> keywords = {"Точка", "Мыс", "Вершина", "Цель", "Point"};
-        while (ss >> word) {
-            std::string upper_word = word;
-            if (!upper_word.empty()) upper_word[0] = std::toupper(static_cast<unsigned char>(upper_word[0]));
-
-            bool is_keyword = std::any_of(keywords.begin(), keywords.end(), [&](const std::string& kw){
-                return upper_word.find(kw) == 0;
-            });
-
-            if (!word.empty() && (std::isupper(static_cast<unsigned char>(word[0])) || is_keyword)) {
-                result_label += word + " ";
-            }
-        }
-        if (!result_label.empty()) {
-            result_label.pop_back();
-            return result_label;
-        }
-    }
-
-    return "";
+    return res;
 }
 
-
 /**
- * @brief Сравнивает две координаты с учетом погрешности (для замкнутого полигона).
+ * @brief Потоковый анализ файла (или stdin для "-") с выводом NDJSON в stdout, без запуска сервера.
+ * Файл читается частями, память ограничена окном StreamAnalyzer независимо от размера файла.
  */
-static bool coords_match(const Coordinate& c1, const Coordinate& c2, double tolerance = 0.0001) {
-    return std::abs(c1.lat_dd - c2.lat_dd) < tolerance &&
-           std::abs(c1.lon_dd - c2.lon_dd) < tolerance;
-}
-
-// --- 3. Основной обработчик логики ---
-
-/**
- * @brief Обрабатывает POST-запрос с текстом, извлекает и классифицирует координаты.
- * @param text Исходный текст для анализа.
- * @return JSON-объект с результатами.
- */
-static json analyze_geo_text(const std::string& text) {
-    // Комплексное регулярное выражение для поиска потенциальных пар координат.
-    // Группы 1/3/5/7 - Опциональные направляющие буквы (N/S/C/Ю/E/W/В/З)
-    // Группы 2/6 - Числовое значение координаты (поддерживает DD/DMS/DDM с разными разделителями . , ° ' " )
-    // Группа 4 - Разделитель между координатами (пробелы, запятые, дефисы, а также слова 'и', 'или', 'через' и переносы строки)
-    // NOTE: Переносы строки (\s*) включены в разделители.
-    const std::regex GEO_PAIR_REGEX(
-        R"(([NSСЮЕWВЗ]?)\s*([\d]{1,3}[°\s']?[\d]{0,2}[.,\s']?[\d]{0,6}[′"\s]?[.,\s']?[\d]{0,6}[″"\s']?)([NSСЮЕWВЗ]?)\s*([\s,\-\/\;]{1,10}|\b(?:и\s|или\s|через\s|и\sточка\s){1,4}\b)\s*([NSСЮЕWВЗ]?)\s*([\d]{1,3}[°\s']?[\d]{0,2}[.,\s']?[\d]{0,6}[′"\s]?[.,\s']?[\d]{0,6}[″"\s']?)([NSСЮЕWВЗ]?))"
-        , std::regex::icase | std::regex::optimize
-    );
-
-    std::vector<Coordinate> found_coords;
-    auto it = text.cbegin();
-    std::smatch match;
-
-    // Ищем все совпадения
-    while (std::regex_search(it, text.cend(), match, GEO_PAIR_REGEX)) {
-        size_t current_pos = std::distance(text.cbegin(), match[0].first);
-
-        std::string lat_str = match[2].str();
-        std::string lon_str = match[6].str();
-
-        // Сбор направляющих символов для широты и долготы
-        std::string dir_lat = match[1].str() + match[3].str(); 
-        std::string dir_lon = match[5].str() + match[7].str();
-
-        Coordinate coord;
-        std::string format1, format2;
-
-        // Попытка нормализации и валидации
-        coord.lat_dd = normalize_and_validate_component(lat_str + dir_lat, true, format1);
-        coord.lon_dd = normalize_and_validate_component(lon_str + dir_lon, false, format2);
-
-        // Если оба компонента валидны, сохраняем результат
-        if (coord.lat_dd != 999.0 && coord.lon_dd != 999.0) {
-            coord.is_valid = true;
-            coord.original_text = match.str();
-            coord.format = (format1 == format2) ? format1 : "Mixed(" + format1 + "/" + format2 + ")";
-            coord.sentence_context = find_sentence_context(text, current_pos, match.length());
-            coord.label = find_label(text, current_pos);
-            found_coords.push_back(coord);
-        }
-
-        // Перемещаем итератор для поиска следующего совпадения после текущего
-        it = match[0].second;
-    }
-
-    // --- Классификация набора координат ---
-
-    std::string coord_type;
-    size_t count = found_coords.size();
-
-    if (count <= 1) {
-        coord_type = "Одиночные точки";
-    } else { // count >= 2
-        coord_type = "Линия";
-        // Проверяем, является ли полигоном (первая и последняя совпадают, и точек >= 3)
-        if (count >= 3 && coords_match(found_coords.front(), found_coords.back())) {
-            coord_type = "Замкнутый полигон";
+static int analyze_file_stream(const std::string& path) {
+    std::ifstream file;
+    std::istream* input = &std::cin;
+    if (path != "-") {
+        file.open(path, std::ios::binary);
+        if (!file.is_open()) {
+            std::cerr << "Не удалось открыть файл: " << path << std::endl;
+            return 1;
         }
+        input = &file;
     }
 
-    // --- Формирование JSON ответа ---
-
-    json response = {
-        {"coordinate_type", coord_type},
-        {"total_found", count},
-        {"coordinates", json::array()}
-    };
-
-    for (const auto& coord : found_coords) {
-        // Форматируем DD для вывода с 4 знаками после запятой
-        std::ostringstream ss;
-        ss << std::fixed << std::setprecision(4)
-           << std::abs(coord.lat_dd) << (coord.lat_dd >= 0 ? "N" : "S") << " "
-           << std::abs(coord.lon_dd) << (coord.lon_dd >= 0 ? "E" : "W");
-        std::string normalized_dd = ss.str();
-
-        response["coordinates"].push_back({
-            {"original", coord.original_text},
-            {"normalized_dd", normalized_dd},
-            {"lat_dd", coord.lat_dd},
-            {"lon_dd", coord.lon_dd},
-            {"format", coord.format},
-            {"is_valid", coord.is_valid},
-            {"label", coord.label.empty() ? "Нет" : coord.label},
-            {"sentence_context", coord.sentence_context}
-        });
+    geo::StreamAnalyzer analyzer([](std::string_view line) { std::cout.write(line.data(), line.size()); });
+    std::string buffer(1 << 20, '\0');
+    while (input->read(buffer.data(), buffer.size()) || input->gcount() > 0) {
+        analyzer.feed(std::string_view(buffer.data(), static_cast<size_t>(input->gcount())));
     }
-
-    return response;
+    analyzer.finish();
+    std::cout.flush();
+    return 0;
 }
 
-// --- 4. Main функция с CLI11 и Crow ---
+// --- Main функция с CLI11 и Crow ---
 
 
 int main(int argc, char* argv[]) {
@@ -332,6 +105,13 @@ int main(int argc, char* argv[]) {
     int port = 8080;
     // Новый параметр для статического контента
     std::string static_path = "static";
+    std::string stream_file;
+    // Пул анализа: пакеты и параллельный разбор больших документов
+    size_t workers = 0;
+    geo::BatchOptions batch;
+    size_t batch_time_budget_ms = static_cast<size_t>(batch.time_budget.count());
+    // Кеш ответов /analyze по содержимому текста
+    size_t cache_max_bytes = 64 * 1024 * 1024;
 
     app.add_option("--host", host, "Хост для прослушивания (по умолчанию: 127.0.0.1)")
         ->type_name("HOST");
@@ -339,6 +119,18 @@ int main(int argc, char* argv[]) {
         ->type_name("PORT");
     app.add_option("--static-path", static_path, "Путь к каталогу статического контента (по умолчанию: static)")
         ->type_name("PATH");
+    app.add_option("--stream", stream_file, "Проанализировать файл (\"-\" - stdin) потоково и вывести NDJSON, не запуская сервер")
+        ->type_name("FILE");
+    app.add_option("--workers", workers, "Потоки пула анализа пакетов и больших документов (по умолчанию: 0 - по числу ядер)")
+        ->type_name("N");
+    app.add_option("--batch-max-documents", batch.max_documents, "Наибольшее число документов в пакете (по умолчанию: 10000)")
+        ->type_name("N")->check(CLI::PositiveNumber);
+    app.add_option("--batch-max-bytes", batch.max_bytes, "Наибольший суммарный размер текстов пакета в байтах (по умолчанию: 64 МиБ)")
+        ->type_name("BYTES")->check(CLI::PositiveNumber);
+    app.add_option("--batch-time-budget-ms", batch_time_budget_ms, "Время на пакет в миллисекундах, 0 - без ограничения (по умолчанию: 30000)")
+        ->type_name("MS");
+    app.add_option("--cache-max-bytes", cache_max_bytes, "Память под кеш ответов /analyze в байтах, 0 - без кеша (по умолчанию: 64 МиБ)")
+        ->type_name("BYTES");
 
     try {
         app.parse(argc, argv);
@@ -346,40 +138,147 @@ int main(int argc, char* argv[]) {
     catch (const CLI::ParseError& e) {
         return app.exit(e);
     }
+    batch.time_budget = std::chrono::milliseconds(batch_time_budget_ms);
+
+    if (!stream_file.empty()) {
+        try {
+            return analyze_file_stream(stream_file);
+        }
+        catch (const std::exception& e) {
+            std::cerr << "Ошибка анализа: " << e.what() << std::endl;
+            return 1;
+        }
+    }
 
     try {
         // --- Crow Setup ---
         crow::SimpleApp crow_app;
+        // Отдельный пул для пакетов и больших документов: потоки Crow только принимают запросы и ждут результата
+        geo::WorkerPool analysis_pool(workers);
+        // Одни и те же документы присылают повторно: ответ хранится по хешу текста и параметров
+        geo::ResultCache result_cache(cache_max_bytes);
+
+        // Статический каталог загружается в память целиком; изменения подхватываются без перезапуска
+        geo::StaticAssets static_assets(static_path);
+        const size_t static_files = static_assets.reload();
+        std::jthread static_watcher;
+        try {
+            static_watcher = std::jthread([&static_assets, watcher = std::make_shared<geo::DirectoryWatcher>(static_path)](std::stop_token stop) {
+                while (!stop.stop_requested()) {
+                    if (watcher->wait_for_change(std::chrono::milliseconds(500))) {
+                        const size_t count = static_assets.reload();
+                        std::cout << "Статический каталог перезагружен, файлов: " << count << std::endl;
+                    }
+                }
+            });
+        }
+        catch (const std::exception& e) {
+            std::cerr << "Изменения статического каталога не отслеживаются: " << e.what() << std::endl;
+        }
 
         // 1. Роут для корневой страницы (/)
         // Явно отдаем index.html при запросе корня.
         CROW_ROUTE(crow_app, "/")
             ([&](const crow::request& req) {
-            std::string index_file_path = static_path + "/index.html";
-            std::ifstream file(index_file_path);
-
-            if (file.is_open()) {
-                std::stringstream buffer;
-                buffer << file.rdbuf();
-                crow::response res(200, buffer.str());
-                res.set_header("Content-Type", "text/html; charset=utf-8");
-                return res;
+            return serve_static(static_assets, req, "index.html");
+                });
+
+        // Остальные файлы статического каталога
+        CROW_ROUTE(crow_app, "/<path>")
+            ([&](const crow::request& req, const std::string& path) {
+            return serve_static(static_assets, req, path);
+                });
+
+        // 2. Роут для анализа текста (POST /analyze): JSON {"text": ...} или сам текст (text/plain)
+        CROW_ROUTE(crow_app, "/analyze")
+            .methods("POST"_method)
+            ([&](const crow::request& req) {
+            // Текст анализируется без копий: text/plain - само тело, в JSON поле "text" ссылается на тело,
+            // если в нём нет escape-последовательностей, иначе разворачивается один раз в unescaped
+            const std::string& content_type = req.get_header_value("Content-Type");
+            std::string unescaped;
+            std::string_view input_text;
+            if (content_type.find("text/plain") != std::string::npos) {
+                input_text = req.body;
+            }
+            else if (content_type.find("application/json") != std::string::npos) {
+                std::optional<std::string_view> text;
+                try {
+                    text = geo::extract_text_field(req.body, unescaped);
+                }
+                catch (const std::invalid_argument& e) {
+                    return crow::response(400, "{\"error\": \"Неверный формат JSON: " + std::string(e.what()) + "\"}");
+                }
+
+                // Проверяем наличие поля "text"
+                if (!text) {
+                    return crow::response(400, "{\"error\": \"Требуется строковое поле 'text' в теле запроса.\"}");
+                }
+                input_text = *text;
             }
             else {
-                return crow::response(404, "{\"error\": \"Не найден файл index.html в статическом каталоге: " + static_path + "\"}");
+                return crow::response(400, "{\"error\": \"Необходим Content-Type: application/json или text/plain\"}");
             }
+
+            // Ответ определяется текстом и параметрами, поэтому ETag известен до анализа:
+            // клиенту с тем же ETag отвечаем 304 без анализа и без обращения к кешу
+            const bool pretty = pretty_requested(req);
+            const geo::CacheKey key = geo::make_cache_key(input_text, pretty);
+            const std::string etag = geo::make_etag(key);
+            if (geo::etag_matches(req.get_header_value("If-None-Match"), etag)) {
+                crow::response res(304);
+                res.set_header("ETag", etag);
+                return res;
+            }
+
+            std::shared_ptr<const std::string> body = result_cache.find(key);
+            const bool cached = body != nullptr;
+            if (!cached) {
+                // Запускаем анализ
+                // Большой текст анализируется по отрезкам на пуле
+                const geo::GeoAnalysis analysis = geo::analyze_geo_text(input_text, &analysis_pool);
+
+                // Ответ пишется сразу в строку тела, без DOM; отступы - только по ?pretty
+                std::string json_body;
+                json_body.reserve(geo::estimate_json_size(analysis, pretty));
+                geo::JsonWriter writer(json_body, pretty);
+                geo::write_analysis_json(writer, analysis);
+                body = std::make_shared<const std::string>(std::move(json_body));
+                result_cache.insert(key, body);
+            }
+
+            // Возвращаем результат
+            crow::response res(200, *body);
+            res.set_header("Content-Type", "application/json; charset=utf-8");
+            res.set_header("ETag", etag);
+            res.set_header("X-Cache", cached ? "HIT" : "MISS");
+            return res;
                 });
 
-        // 2. Роут для анализа текста (POST /analyze) - остается без изменений
-        CROW_ROUTE(crow_app, "/analyze")
+        // 3. Потоковый анализ (POST /analyze/stream): тело - сам текст, ответ - NDJSON.
+        // Каждая координата - отдельная строка, последняя строка - классификация набора
+        CROW_ROUTE(crow_app, "/analyze/stream")
+            .methods("POST"_method)
+            ([&](const crow::request& req) {
+            std::string ndjson;
+            geo::StreamAnalyzer analyzer([&](std::string_view line) { ndjson += line; });
+            analyzer.feed(req.body);
+            analyzer.finish();
+
+            crow::response res(200, std::move(ndjson));
+            res.set_header("Content-Type", "application/x-ndjson; charset=utf-8");
+            return res;
+                });
+
+        // 4. Пакетный анализ (POST /analyze/batch): массив документов - строк или объектов с полем "text".
+        // Ответ - массив результатов в порядке документов, каждый в формате /analyze
+        CROW_ROUTE(crow_app, "/analyze/batch")
             .methods("POST"_method)
             ([&](const crow::request& req) {
-            // Проверяем Content-Type
             if (req.get_header_value("Content-Type").find("application/json") == std::string::npos) {
                 return crow::response(400, "{\"error\": \"Необходим Content-Type: application/json\"}");
             }
 
-            // Парсим JSON тела запроса
             json req_json;
             try {
                 req_json = json::parse(req.body);
@@ -387,28 +286,77 @@ int main(int argc, char* argv[]) {
             catch (const json::parse_error& e) {
                 return crow::response(400, "{\"error\": \"Неверный формат JSON: " + std::string(e.what()) + "\"}");
             }
+            if (!req_json.is_array()) {
+                return crow::response(400, "{\"error\": \"Требуется массив документов: строк или объектов с полем 'text'.\"}");
+            }
+            if (req_json.size() > batch.max_documents) {
+                return crow::response(413, "{\"error\": \"Слишком много документов в пакете, наибольшее число: "
+                    + std::to_string(batch.max_documents) + "\"}");
+            }
 
-            // Проверяем наличие поля "text"
-            if (!req_json.contains("text") || !req_json["text"].is_string()) {
-                return crow::response(400, "{\"error\": \"Требуется строковое поле 'text' в теле запроса.\"}");
+            std::vector<std::string> documents;
+            documents.reserve(req_json.size());
+            size_t total_bytes = 0;
+            for (auto& item : req_json) {
+                json* text = &item;
+                if (item.is_object() && item.contains("text")) {
+                    text = &item["text"];
+                }
+                if (!text->is_string()) {
+                    return crow::response(400, "{\"error\": \"Документ " + std::to_string(documents.size())
+                        + " должен быть строкой или объектом со строковым полем 'text'.\"}");
+                }
+                documents.push_back(std::move(text->get_ref<std::string&>()));
+                total_bytes += documents.back().size();
+                if (total_bytes > batch.max_bytes) {
+                    return crow::response(413, "{\"error\": \"Суммарный размер текстов пакета превышает "
+                        + std::to_string(batch.max_bytes) + " байт\"}");
+                }
             }
 
-            std::string input_text = req_json["text"].get<std::string>();
+            geo::BatchResult result = geo::analyze_batch(analysis_pool, std::move(documents), batch.time_budget,
+                pretty_requested(req));
+            if (result.timed_out) {
+                return crow::response(503, "{\"error\": \"Превышено время на пакет, проанализировано документов: "
+                    + std::to_string(result.analyzed) + "\"}");
+            }
+            if (!result.completed) {
+                return crow::response(500, json{ {"error", "Ошибка анализа: " + result.error} }.dump());
+            }
 
-            // Запускаем анализ
-            json result_json = analyze_geo_text(input_text);
+            crow::response res(200, std::move(result.json));
+            res.set_header("Content-Type", "application/json; charset=utf-8");
+            return res;
+                });
 
-            // Возвращаем результат
-            crow::response res(200, result_json.dump(4));
+        // 5. Счётчики кеша ответов (GET /cache/stats)
+        CROW_ROUTE(crow_app, "/cache/stats")
+            ([&]() {
+            const geo::CacheStats stats = result_cache.stats();
+            std::string body;
+            geo::JsonWriter writer(body, false);
+            writer.begin_object();
+            writer.key("bytes").value(stats.bytes);
+            writer.key("entries").value(stats.entries);
+            writer.key("evictions").value(static_cast<size_t>(stats.evictions));
+            writer.key("hits").value(static_cast<size_t>(stats.hits));
+            writer.key("max_bytes").value(stats.max_bytes);
+            writer.key("misses").value(static_cast<size_t>(stats.misses));
+            writer.end_object();
+
+            crow::response res(200, std::move(body));
             res.set_header("Content-Type", "application/json; charset=utf-8");
             return res;
                 });
 
         // Стартуем сервер
         std::cout << "Запуск Geo-аналитического HTTP-сервиса на " << host << ":" << port << "..." << std::endl;
-        std::cout << "Статический контент раздается из каталога: " << static_path << std::endl;
+        std::cout << "Статический контент раздается из памяти, каталог: " << static_path << ", файлов: " << static_files << std::endl;
         std::cout << "Веб-интерфейс доступен по адресу: http://" << host << ":" << port << std::endl;
         std::cout << "API /analyze ожидает POST-запросы с полем 'text'." << std::endl;
+        std::cout << "API /analyze/batch принимает массив документов, потоков анализа: " << analysis_pool.size() << std::endl;
+        std::cout << "API /analyze/stream принимает текст в теле запроса и отвечает NDJSON." << std::endl;
+        std::cout << "Кеш ответов /analyze: " << cache_max_bytes << " байт, счётчики - GET /cache/stats" << std::endl;
         std::cout << "Для остановки нажмите Ctrl+C." << std::endl;
 
         crow_app.bindaddr(host).port(port).multithreaded().run();
@@ -0,0 +1,363 @@
+#include "request_text.hpp"
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace geo
+{
+    namespace {
+        // Байты, которые внутри строки JSON не требуют разбора: всё, кроме кавычки, '\' и управляющих
+        constexpr std::array<bool, 256> make_plain_table() {
+            std::array<bool, 256> table{};
+            for (int c = 0x20; c < 256; ++c) {
+                table[c] = c != '"' && c != '\\';
+            }
+            return table;
+        }
+        constexpr std::array<bool, 256> kPlain = make_plain_table();
+
+        /**
+         * @brief Однопроходный разбор тела: значения проверяются и пропускаются, строки - без копирования.
+         */
+        class TextFieldReader
+        {
+        public:
+            explicit TextFieldReader(std::string_view body) : body_(body) {
+                // Как и nlohmann::json::parse, допускаем BOM UTF-8 в начале
+                if (body_.substr(0, 3) == "\xEF\xBB\xBF") {
+                    pos_ = 3;
+                }
+            }
+
+            std::optional<std::string_view> read(std::string& buffer) {
+                std::optional<std::string_view> text;
+                skip_whitespace();
+                if (peek() != '{') {
+                    skip_value();
+                    finish();
+                    return text;
+                }
+
+                ++pos_;
+                skip_whitespace();
+                if (peek() == '}') {
+                    ++pos_;
+                    finish();
+                    return text;
+                }
+                for (;;) {
+                    expect('"');
+                    const std::string_view key = string(&key_buffer_);
+                    skip_whitespace();
+                    expect(':');
+                    skip_whitespace();
+                    if (key == "text") {
+                        // Повторный ключ заменяет значение, как в DOM
+                        if (peek() == '"') {
+                            ++pos_;
+                            text = string(&buffer);
+                        }
+                        else {
+                            text.reset();
+                            skip_value();
+                        }
+                    }
+                    else {
+                        skip_value();
+                    }
+                    skip_whitespace();
+                    if (peek() == ',') {
+                        ++pos_;
+                        skip_whitespace();
+                        continue;
+                    }
+                    expect('}');
+                    break;
+                }
+                finish();
+                return text;
+            }
+
+        private:
+            [[noreturn]] void fail(const char* what) const {
+                throw std::invalid_argument(std::string(what) + " at byte " + std::to_string(pos_));
+            }
+
+            // '\0' в конце тела: ни одно правило грамматики с него не начинается
+            char peek() const { return pos_ < body_.size() ? body_[pos_] : '\0'; }
+
+            void expect(char c) {
+                if (peek() != c) {
+                    fail(pos_ < body_.size() ? "unexpected character" : "unexpected end of input");
+                }
+                ++pos_;
+            }
+
+            void skip_whitespace() {
+                while (pos_ < body_.size()) {
+                    const char c = body_[pos_];
+                    if (c != ' ' && c != '\t' && c != '\n' && c != '\r') {
+                        break;
+                    }
+                    ++pos_;
+                }
+            }
+
+            void finish() {
+                skip_whitespace();
+                if (pos_ != body_.size()) {
+                    fail("unexpected trailing data");
+                }
+            }
+
+            /**
+             * @brief Строка после открывающей кавычки. Без escape-последовательностей - представление body;
+             * иначе, если передан unescaped, строка разворачивается в него. nullptr - только проверка.
+             */
+            std::string_view string(std::string* unescaped) {
+                const std::size_t begin = pos_;
+                while (pos_ < body_.size() && kPlain[static_cast<unsigned char>(body_[pos_])]) {
+                    ++pos_;
+                }
+                if (peek() == '"') {
+                    return body_.substr(begin, pos_++ - begin);
+                }
+
+                if (unescaped) {
+                    // Развёрнутая строка не длиннее исходной - одно выделение памяти
+                    unescaped->clear();
+                    unescaped->reserve(body_.size() - begin);
+                    unescaped->append(body_.data() + begin, pos_ - begin);
+                }
+                for (;;) {
+                    const std::size_t run = pos_;
+                    while (pos_ < body_.size() && kPlain[static_cast<unsigned char>(body_[pos_])]) {
+                        ++pos_;
+                    }
+                    if (unescaped) {
+                        unescaped->append(body_.data() + run, pos_ - run);
+                    }
+                    const char c = peek();
+                    if (c == '"') {
+                        ++pos_;
+                        return unescaped ? std::string_view(*unescaped) : std::string_view();
+                    }
+                    if (c != '\\') {
+                        fail(pos_ < body_.size() ? "control character in string" : "unterminated string");
+                    }
+                    ++pos_;
+                    escape(unescaped);
+                }
+            }
+
+            void escape(std::string* out) {
+                char decoded;
+                switch (peek()) {
+                case '"': decoded = '"'; break;
+                case '\\': decoded = '\\'; break;
+                case '/': decoded = '/'; break;
+                case 'b': decoded = '\b'; break;
+                case 'f': decoded = '\f'; break;
+                case 'n': decoded = '\n'; break;
+                case 'r': decoded = '\r'; break;
+                case 't': decoded = '\t'; break;
+                case 'u': {
+                    ++pos_;
+                    std::uint32_t cp = hex4();
+                    if (cp >= 0xDC00 && cp <= 0xDFFF) {
+                        fail("unpaired surrogate");
+                    }
+                    if (cp >= 0xD800 && cp <= 0xDBFF) {
+                        if (peek() != '\\' || pos_ + 1 >= body_.size() || body_[pos_ + 1] != 'u') {
+                            fail("unpaired surrogate");
+                        }
+                        pos_ += 2;
+                        const std::uint32_t low = hex4();
+                        if (low < 0xDC00 || low > 0xDFFF) {
+                            fail("unpaired surrogate");
+                        }
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    if (out) {
+                        append_utf8(*out, cp);
+                    }
+                    return;
+                }
+                default:
+                    fail("invalid escape");
+                }
+                ++pos_;
+                if (out) {
+                    *out += decoded;
+                }
+            }
+
+            std::uint32_t hex4() {
+                std::uint32_t value = 0;
+                for (int i = 0; i < 4; ++i) {
+                    const char c = peek();
+                    std::uint32_t digit;
+                    if (c >= '0' && c <= '9') {
+                        digit = c - '0';
+                    }
+                    else if (c >= 'a' && c <= 'f') {
+                        digit = c - 'a' + 10;
+                    }
+                    else if (c >= 'A' && c <= 'F') {
+                        digit = c - 'A' + 10;
+                    }
+                    else {
+                        fail("invalid \\u escape");
+                    }
+                    value = value * 16 + digit;
+                    ++pos_;
+                }
+                return value;
+            }
+
+            static void append_utf8(std::string& out, std::uint32_t cp) {
+                if (cp < 0x80) {
+                    out += static_cast<char>(cp);
+                }
+                else if (cp < 0x800) {
+                    out += static_cast<char>(0xC0 | (cp >> 6));
+                    out += static_cast<char>(0x80 | (cp & 0x3F));
+                }
+                else if (cp < 0x10000) {
+                    out += static_cast<char>(0xE0 | (cp >> 12));
+                    out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                    out += static_cast<char>(0x80 | (cp & 0x3F));
+                }
+                else {
+                    out += static_cast<char>(0xF0 | (cp >> 18));
+                    out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+                    out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                    out += static_cast<char>(0x80 | (cp & 0x3F));
+                }
+            }
+
+            void digits() {
+                if (peek() < '0' || peek() > '9') {
+                    fail("invalid number");
+                }
+                while (peek() >= '0' && peek() <= '9') {
+                    ++pos_;
+                }
+            }
+
+            void number() {
+                if (peek() == '-') {
+                    ++pos_;
+                }
+                if (peek() == '0') {
+                    ++pos_;
+                }
+                else {
+                    digits();
+                }
+                if (peek() == '.') {
+                    ++pos_;
+                    digits();
+                }
+                if (peek() == 'e' || peek() == 'E') {
+                    ++pos_;
+                    if (peek() == '+' || peek() == '-') {
+                        ++pos_;
+                    }
+                    digits();
+                }
+            }
+
+            void literal(std::string_view word) {
+                if (body_.substr(pos_, word.size()) != word) {
+                    fail("invalid literal");
+                }
+                pos_ += word.size();
+            }
+
+            /**
+             * @brief Пропускает одно значение любой вложенности; стек явный, глубина тела не ограничена стеком вызовов.
+             */
+            void skip_value() {
+                closers_.clear();
+                for (;;) {
+                    skip_whitespace();
+                    bool scalar = true;
+                    switch (peek()) {
+                    case '{':
+                        ++pos_;
+                        skip_whitespace();
+                        if (peek() == '}') {
+                            ++pos_;
+                        }
+                        else {
+                            closers_.push_back('}');
+                            member_key();
+                            scalar = false;
+                        }
+                        break;
+                    case '[':
+                        ++pos_;
+                        skip_whitespace();
+                        if (peek() == ']') {
+                            ++pos_;
+                        }
+                        else {
+                            closers_.push_back(']');
+                            scalar = false;
+                        }
+                        break;
+                    case '"':
+                        ++pos_;
+                        string(nullptr);
+                        break;
+                    case 't': literal("true"); break;
+                    case 'f': literal("false"); break;
+                    case 'n': literal("null"); break;
+                    default:
+                        number();
+                        break;
+                    }
+                    if (!scalar) {
+                        continue;
+                    }
+
+                    // После значения: следующий элемент текущего контейнера или закрытие контейнеров
+                    for (;;) {
+                        if (closers_.empty()) {
+                            return;
+                        }
+                        skip_whitespace();
+                        if (peek() == ',') {
+                            ++pos_;
+                            if (closers_.back() == '}') {
+                                member_key();
+                            }
+                            break;
+                        }
+                        expect(closers_.back());
+                        closers_.pop_back();
+                    }
+                }
+            }
+
+            void member_key() {
+                skip_whitespace();
+                expect('"');
+                string(nullptr);
+                skip_whitespace();
+                expect(':');
+            }
+
+            std::string_view body_;
+            std::size_t pos_ = 0;
+            std::string key_buffer_;
+            std::vector<char> closers_;    ///< Ожидаемые закрывающие скобки пропускаемого значения
+        };
+    }
+
+    std::optional<std::string_view> extract_text_field(std::string_view body, std::string& buffer) {
+        return TextFieldReader(body).read(buffer);
+    }
+}
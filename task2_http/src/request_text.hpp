@@ -0,0 +1,21 @@
+#pragma once
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace geo
+{
+    /**
+     * @brief Извлекает строковое поле "text" из JSON-объекта тела запроса без построения DOM.
+     *
+     * Тело проверяется целиком за один проход (синтаксис JSON, как у nlohmann::json::parse), остальные
+     * поля только пропускаются. Строка без escape-последовательностей не копируется: результат ссылается
+     * прямо на body. Иначе она один раз разворачивается в buffer. При повторе ключа действует последнее значение.
+     *
+     * @param body Тело запроса.
+     * @param buffer Буфер для строки с escape-последовательностями; должен жить, пока используется результат.
+     * @return Текст поля (в body или в buffer); std::nullopt, если тело - не объект или "text" нет либо это не строка.
+     * @throws std::invalid_argument Тело - некорректный JSON; в сообщении - смещение ошибки.
+     */
+    std::optional<std::string_view> extract_text_field(std::string_view body, std::string& buffer);
+}
@@ -0,0 +1,211 @@
+#include "result_cache.hpp"
+#include <cstring>
+#include <utility>
+
+namespace geo
+{
+    namespace {
+        static_assert(ResultCache::kShards == 16, "shard_for() takes the top 4 bits of the hash");
+
+        // XXH64: несколько ГБ/с - хеш большого текста на порядок дешевле его анализа
+        constexpr std::uint64_t kPrime1 = 0x9E3779B185EBCA87ULL;
+        constexpr std::uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+        constexpr std::uint64_t kPrime3 = 0x165667B19E3779F9ULL;
+        constexpr std::uint64_t kPrime4 = 0x85EBCA77C2B2AE63ULL;
+        constexpr std::uint64_t kPrime5 = 0x27D4EB2F165667C5ULL;
+
+        std::uint64_t rotate_left(std::uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+        std::uint64_t read64(const char* p) {
+            std::uint64_t value;
+            std::memcpy(&value, p, sizeof(value));
+            return value;
+        }
+
+        std::uint32_t read32(const char* p) {
+            std::uint32_t value;
+            std::memcpy(&value, p, sizeof(value));
+            return value;
+        }
+
+        std::uint64_t mix_round(std::uint64_t acc, std::uint64_t input) {
+            acc += input * kPrime2;
+            acc = rotate_left(acc, 31);
+            return acc * kPrime1;
+        }
+
+        std::uint64_t merge_round(std::uint64_t acc, std::uint64_t value) {
+            acc ^= mix_round(0, value);
+            return acc * kPrime1 + kPrime4;
+        }
+
+        std::uint64_t xxh64(std::string_view data, std::uint64_t seed) {
+            const char* p = data.data();
+            const char* const end = p + data.size();
+            std::uint64_t h;
+
+            if (data.size() >= 32) {
+                std::uint64_t v1 = seed + kPrime1 + kPrime2;
+                std::uint64_t v2 = seed + kPrime2;
+                std::uint64_t v3 = seed;
+                std::uint64_t v4 = seed - kPrime1;
+                const char* const limit = end - 32;
+                do {
+                    v1 = mix_round(v1, read64(p));
+                    v2 = mix_round(v2, read64(p + 8));
+                    v3 = mix_round(v3, read64(p + 16));
+                    v4 = mix_round(v4, read64(p + 24));
+                    p += 32;
+                } while (p <= limit);
+                h = rotate_left(v1, 1) + rotate_left(v2, 7) + rotate_left(v3, 12) + rotate_left(v4, 18);
+                h = merge_round(h, v1);
+                h = merge_round(h, v2);
+                h = merge_round(h, v3);
+                h = merge_round(h, v4);
+            }
+            else {
+                h = seed + kPrime5;
+            }
+            h += data.size();
+
+            for (; p + 8 <= end; p += 8) {
+                h ^= mix_round(0, read64(p));
+                h = rotate_left(h, 27) * kPrime1 + kPrime4;
+            }
+            if (p + 4 <= end) {
+                h ^= read32(p) * kPrime1;
+                h = rotate_left(h, 23) * kPrime2 + kPrime3;
+                p += 4;
+            }
+            for (; p < end; ++p) {
+                h ^= static_cast<unsigned char>(*p) * kPrime5;
+                h = rotate_left(h, 11) * kPrime1;
+            }
+
+            h ^= h >> 33;
+            h *= kPrime2;
+            h ^= h >> 29;
+            h *= kPrime3;
+            h ^= h >> 32;
+            return h;
+        }
+
+        void append_hex(std::string& out, std::uint64_t value) {
+            constexpr char kHex[] = "0123456789abcdef";
+            for (int shift = 60; shift >= 0; shift -= 4) {
+                out += kHex[(value >> shift) & 0x0F];
+            }
+        }
+
+        std::string_view trim(std::string_view s) {
+            while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) {
+                s.remove_prefix(1);
+            }
+            while (!s.empty() && (s.back() == ' ' || s.back() == '\t')) {
+                s.remove_suffix(1);
+            }
+            return s;
+        }
+    }
+
+    CacheKey make_cache_key(std::string_view text, bool pretty) {
+        return { xxh64(text, pretty ? 1 : 0), text.size() };
+    }
+
+    std::string make_etag(const CacheKey& key) {
+        std::string etag;
+        etag.reserve(36);
+        etag += '"';
+        append_hex(etag, key.hash);
+        etag += '-';
+        append_hex(etag, key.size);
+        etag += '"';
+        return etag;
+    }
+
+    bool etag_matches(std::string_view if_none_match, std::string_view etag) {
+        while (!if_none_match.empty()) {
+            const std::size_t comma = if_none_match.find(',');
+            std::string_view candidate = trim(if_none_match.substr(0, comma));
+            if (candidate == "*") {
+                return true;
+            }
+            if (candidate.substr(0, 2) == "W/") {
+                candidate.remove_prefix(2);
+            }
+            if (candidate == etag) {
+                return true;
+            }
+            if (comma == std::string_view::npos) {
+                break;
+            }
+            if_none_match.remove_prefix(comma + 1);
+        }
+        return false;
+    }
+
+    ResultCache::ResultCache(std::size_t max_bytes)
+        : max_bytes_(max_bytes), shard_max_bytes_(max_bytes / kShards) {
+    }
+
+    std::shared_ptr<const std::string> ResultCache::find(const CacheKey& key) {
+        if (!enabled()) {
+            return nullptr;
+        }
+        Shard& shard = shard_for(key);
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            const auto it = shard.index.find(key.hash);
+            if (it != shard.index.end() && it->second->key == key) {
+                shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+                ++hits_;
+                return it->second->body;
+            }
+        }
+        ++misses_;
+        return nullptr;
+    }
+
+    void ResultCache::insert(const CacheKey& key, std::shared_ptr<const std::string> body) {
+        const std::size_t cost = body->size() + kEntryOverhead;
+        if (!enabled() || cost > shard_max_bytes_) {
+            return;
+        }
+        Shard& shard = shard_for(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        // Тот же ключ мог быть сохранён параллельным запросом - запись заменяется
+        const auto it = shard.index.find(key.hash);
+        if (it != shard.index.end()) {
+            shard.bytes -= it->second->cost;
+            shard.lru.erase(it->second);
+            shard.index.erase(it);
+        }
+
+        while (shard.bytes + cost > shard_max_bytes_) {
+            const Entry& oldest = shard.lru.back();
+            shard.bytes -= oldest.cost;
+            shard.index.erase(oldest.key.hash);
+            shard.lru.pop_back();
+            ++evictions_;
+        }
+
+        shard.lru.push_front(Entry{ key, std::move(body), cost });
+        shard.index.emplace(key.hash, shard.lru.begin());
+        shard.bytes += cost;
+    }
+
+    CacheStats ResultCache::stats() const {
+        CacheStats stats;
+        stats.hits = hits_.load();
+        stats.misses = misses_.load();
+        stats.evictions = evictions_.load();
+        stats.max_bytes = max_bytes_;
+        for (const Shard& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            stats.entries += shard.index.size();
+            stats.bytes += shard.bytes;
+        }
+        return stats;
+    }
+}
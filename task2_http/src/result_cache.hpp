@@ -0,0 +1,115 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace geo
+{
+    /**
+     * @brief Ключ ответа по содержимому: 64-битный хеш текста и параметров ответа и длина текста.
+     */
+    struct CacheKey {
+        std::uint64_t hash = 0;     ///< XXH64 текста с параметрами ответа в качестве seed
+        std::size_t size = 0;       ///< Длина текста - дополнительная защита от коллизий
+
+        bool operator==(const CacheKey&) const = default;
+    };
+
+    /**
+     * @brief Ключ ответа /analyze для текста; pretty входит в ключ, так как меняет тело ответа.
+     */
+    CacheKey make_cache_key(std::string_view text, bool pretty);
+
+    /**
+     * @brief Сильный ETag ответа: "<хеш>-<длина>" в шестнадцатеричном виде, в кавычках.
+     * Ответ определяется текстом и параметрами, поэтому ETag известен до анализа.
+     */
+    std::string make_etag(const CacheKey& key);
+
+    /**
+     * @brief Совпадает ли заголовок If-None-Match (список ETag через запятую или "*") с etag.
+     * Сравнение слабое, как требует RFC 9110 для If-None-Match: префикс W/ не учитывается.
+     */
+    bool etag_matches(std::string_view if_none_match, std::string_view etag);
+
+    /**
+     * @brief Счётчики кеша; entries и bytes - мгновенное состояние.
+     */
+    struct CacheStats {
+        std::uint64_t hits = 0;
+        std::uint64_t misses = 0;
+        std::uint64_t evictions = 0;    ///< Вытеснено записей из-за ограничения памяти
+        std::size_t entries = 0;
+        std::size_t bytes = 0;          ///< Занято памяти с учётом накладных расходов на запись
+        std::size_t max_bytes = 0;
+    };
+
+    /**
+     * @brief Ограниченный по памяти LRU-кеш сериализованных ответов, разбитый на сегменты.
+     *
+     * Сегмент выбирается по старшим битам хеша, у каждого свой мьютекс и своя доля лимита памяти,
+     * поэтому потоки Crow с разными текстами не ждут друг друга. Тела хранятся в shared_ptr:
+     * под мьютексом только поиск и перестановка в списке, копирование в ответ - после.
+     * Ответ больше доли сегмента не кешируется. max_bytes = 0 отключает кеш.
+     */
+    class ResultCache
+    {
+    public:
+        static constexpr std::size_t kShards = 16;
+        static constexpr std::size_t kEntryOverhead = 128;     ///< Оценка памяти записи сверх тела: узлы списка и таблицы
+
+        explicit ResultCache(std::size_t max_bytes);
+
+        ResultCache(const ResultCache&) = delete;
+        ResultCache& operator=(const ResultCache&) = delete;
+
+        /**
+         * @brief Ответ по ключу или nullptr; найденная запись становится самой свежей в сегменте.
+         */
+        std::shared_ptr<const std::string> find(const CacheKey& key);
+
+        /**
+         * @brief Сохраняет ответ, вытесняя самые старые записи сегмента при превышении лимита.
+         */
+        void insert(const CacheKey& key, std::shared_ptr<const std::string> body);
+
+        CacheStats stats() const;
+
+        bool enabled() const { return max_bytes_ > 0; }
+
+    private:
+        struct Entry {
+            CacheKey key;
+            std::shared_ptr<const std::string> body;
+            std::size_t cost = 0;
+        };
+
+        // Хеш уже равномерный - таблица берёт его как есть
+        struct IdentityHash {
+            std::size_t operator()(std::uint64_t hash) const { return static_cast<std::size_t>(hash); }
+        };
+
+        struct Shard {
+            mutable std::mutex mutex;
+            std::list<Entry> lru;      ///< В начале - самые свежие
+            std::unordered_map<std::uint64_t, std::list<Entry>::iterator, IdentityHash> index;
+            std::size_t bytes = 0;
+        };
+
+        Shard& shard_for(const CacheKey& key) { return shards_[key.hash >> 60]; }
+
+        std::size_t max_bytes_;
+        std::size_t shard_max_bytes_;
+        std::array<Shard, kShards> shards_;
+        std::atomic<std::uint64_t> hits_{ 0 };
+        std::atomic<std::uint64_t> misses_{ 0 };
+        std::atomic<std::uint64_t> evictions_{ 0 };
+    };
+}
@@ -0,0 +1,204 @@
+#include "static_assets.hpp"
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+#include <zlib.h>
+
+#include "result_cache.hpp"
+
+namespace geo
+{
+    namespace fs = std::filesystem;
+
+    namespace {
+        struct MimeEntry {
+            std::string_view extension;
+            std::string_view type;
+            bool compressible;      ///< Текстовые форматы; изображения и шрифты woff уже сжаты
+        };
+
+        constexpr std::array<MimeEntry, 22> kMimeTypes{ {
+            { ".html", "text/html; charset=utf-8", true },
+            { ".htm", "text/html; charset=utf-8", true },
+            { ".css", "text/css; charset=utf-8", true },
+            { ".js", "text/javascript; charset=utf-8", true },
+            { ".mjs", "text/javascript; charset=utf-8", true },
+            { ".json", "application/json; charset=utf-8", true },
+            { ".map", "application/json; charset=utf-8", true },
+            { ".txt", "text/plain; charset=utf-8", true },
+            { ".xml", "application/xml; charset=utf-8", true },
+            { ".svg", "image/svg+xml", true },
+            { ".ico", "image/x-icon", true },
+            { ".wasm", "application/wasm", true },
+            { ".ttf", "font/ttf", true },
+            { ".otf", "font/otf", true },
+            { ".png", "image/png", false },
+            { ".jpg", "image/jpeg", false },
+            { ".jpeg", "image/jpeg", false },
+            { ".gif", "image/gif", false },
+            { ".webp", "image/webp", false },
+            { ".woff", "font/woff", false },
+            { ".woff2", "font/woff2", false },
+            { ".pdf", "application/pdf", false },
+        } };
+
+        constexpr MimeEntry kDefaultMime{ "", "application/octet-stream", false };
+
+        const MimeEntry& find_mime(const fs::path& path) {
+            std::string extension = path.extension().string();
+            for (char& c : extension) {
+                if (c >= 'A' && c <= 'Z') {
+                    c = static_cast<char>(c - 'A' + 'a');
+                }
+            }
+            for (const MimeEntry& entry : kMimeTypes) {
+                if (entry.extension == extension) {
+                    return entry;
+                }
+            }
+            return kDefaultMime;
+        }
+
+        // IMF-fixdate (RFC 9110): "Sun, 06 Nov 1994 08:49:37 GMT"; имена дней и месяцев не зависят от локали
+        std::string http_date(fs::file_time_type mtime) {
+            const auto system_time = std::chrono::time_point_cast<std::chrono::seconds>(
+                std::chrono::file_clock::to_sys(mtime));
+            const std::time_t time = std::chrono::system_clock::to_time_t(system_time);
+            std::tm tm{};
+#ifdef _WIN32
+            gmtime_s(&tm, &time);
+#else
+            gmtime_r(&time, &tm);
+#endif
+            static constexpr const char* kDays[] = { "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat" };
+            static constexpr const char* kMonths[] = { "Jan", "Feb", "Mar", "Apr", "May", "Jun",
+                "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
+            char buffer[32];
+            std::snprintf(buffer, sizeof(buffer), "%s, %02d %s %04d %02d:%02d:%02d GMT",
+                kDays[tm.tm_wday], tm.tm_mday, kMonths[tm.tm_mon], tm.tm_year + 1900, tm.tm_hour, tm.tm_min, tm.tm_sec);
+            return buffer;
+        }
+
+        std::string read_file(const fs::path& path, std::uintmax_t size) {
+            std::ifstream file(path, std::ios::binary);
+            if (!file.is_open()) {
+                return {};
+            }
+            std::string data(static_cast<std::size_t>(size), '\0');
+            file.read(data.data(), static_cast<std::streamsize>(data.size()));
+            data.resize(static_cast<std::size_t>(file.gcount()));
+            return data;
+        }
+
+        std::shared_ptr<const StaticAsset> load_asset(const fs::path& path, std::uintmax_t size, fs::file_time_type mtime) {
+            auto asset = std::make_shared<StaticAsset>();
+            asset->body = read_file(path, size);
+            asset->file_size = size;
+            asset->mtime = mtime;
+
+            const MimeEntry& mime = find_mime(path);
+            asset->content_type = mime.type;
+            asset->etag = make_etag(make_cache_key(asset->body, false));
+            asset->last_modified = http_date(mtime);
+            if (mime.compressible && !asset->body.empty()) {
+                std::string compressed = gzip_compress(asset->body);
+                if (compressed.size() < asset->body.size()) {
+                    asset->gzip = std::move(compressed);
+                    asset->gzip_etag = asset->etag;
+                    asset->gzip_etag.insert(asset->gzip_etag.size() - 1, "-gz");
+                }
+            }
+            return asset;
+        }
+    }
+
+    std::string_view mime_type(const fs::path& path) {
+        return find_mime(path).type;
+    }
+
+    std::string gzip_compress(std::string_view data) {
+        z_stream stream{};
+        // windowBits 15 + 16: заголовок и контрольная сумма gzip вместо zlib
+        if (deflateInit2(&stream, Z_BEST_COMPRESSION, Z_DEFLATED, 15 + 16, 9, Z_DEFAULT_STRATEGY) != Z_OK) {
+            throw std::runtime_error("deflateInit2 failed");
+        }
+        std::string out(deflateBound(&stream, static_cast<uLong>(data.size())), '\0');
+        stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+        stream.avail_in = static_cast<uInt>(data.size());
+        stream.next_out = reinterpret_cast<Bytef*>(out.data());
+        stream.avail_out = static_cast<uInt>(out.size());
+        const int result = deflate(&stream, Z_FINISH);
+        out.resize(stream.total_out);
+        deflateEnd(&stream);
+        if (result != Z_STREAM_END) {
+            throw std::runtime_error("deflate failed");
+        }
+        return out;
+    }
+
+    StaticAssets::StaticAssets(std::string root)
+        : root_(std::move(root)), snapshot_(std::make_shared<const Snapshot>()) {
+    }
+
+    std::shared_ptr<const StaticAssets::Snapshot> StaticAssets::snapshot() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return snapshot_;
+    }
+
+    std::size_t StaticAssets::reload() {
+        const std::shared_ptr<const Snapshot> previous = snapshot();
+        auto next = std::make_shared<Snapshot>();
+
+        std::error_code ec;
+        const fs::path root(root_);
+        for (auto it = fs::recursive_directory_iterator(root, ec); !ec && it != fs::recursive_directory_iterator(); it.increment(ec)) {
+            const fs::path& path = it->path();
+            if (path.filename().string().front() == '.') {
+                // Скрытые файлы и каталоги: временные файлы редакторов, .git
+                std::error_code dir_ec;
+                if (it->is_directory(dir_ec)) {
+                    it.disable_recursion_pending();
+                }
+                continue;
+            }
+            std::error_code file_ec;
+            if (!it->is_regular_file(file_ec)) {
+                continue;
+            }
+            const std::uintmax_t size = it->file_size(file_ec);
+            const fs::file_time_type mtime = it->last_write_time(file_ec);
+            if (file_ec || size > kMaxFileBytes) {
+                continue;
+            }
+
+            std::string key = path.lexically_relative(root).generic_string();
+            const auto old = previous->find(key);
+            if (old != previous->end() && old->second->file_size == size && old->second->mtime == mtime) {
+                next->emplace(std::move(key), old->second);
+            }
+            else {
+                next->emplace(std::move(key), load_asset(path, size, mtime));
+            }
+        }
+
+        const std::size_t count = next->size();
+        std::lock_guard<std::mutex> lock(mutex_);
+        snapshot_ = std::move(next);
+        return count;
+    }
+
+    std::shared_ptr<const StaticAsset> StaticAssets::find(std::string_view path) const {
+        std::string key(path);
+        if (key.empty() || key.back() == '/') {
+            key += "index.html";
+        }
+        const std::shared_ptr<const Snapshot> current = snapshot();
+        const auto it = current->find(key);
+        return it != current->end() ? it->second : nullptr;
+    }
+}
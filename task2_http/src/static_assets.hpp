@@ -0,0 +1,74 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace geo
+{
+    /**
+     * @brief Файл статического каталога, подготовленный к отдаче: тело, gzip-вариант и заголовки.
+     */
+    struct StaticAsset {
+        std::string body;
+        std::string gzip;                   ///< Сжатое тело; пусто, если тип не сжимается или сжатие не уменьшает размер
+        std::string_view content_type;      ///< Строка из таблицы типов по расширению
+        std::string etag;                   ///< ETag несжатого тела
+        std::string gzip_etag;              ///< ETag gzip-варианта: у разных представлений разные сильные ETag
+        std::string last_modified;          ///< Время изменения файла в формате HTTP-date
+        std::uintmax_t file_size = 0;       ///< Размер и время изменения файла - чтобы при перезагрузке
+        std::filesystem::file_time_type mtime{};   ///< не читать и не сжимать заново неизменившиеся файлы
+    };
+
+    /**
+     * @brief Все файлы каталога статического контента в памяти.
+     *
+     * reload() строит новый набор целиком и подменяет им прежний; find() только копирует shared_ptr
+     * под мьютексом, поэтому запросы не обращаются к диску и не ждут перезагрузки. Неизменившиеся файлы
+     * (тот же размер и время изменения) переходят в новый набор без повторного чтения и сжатия.
+     * Скрытые файлы (имя с точки) и файлы больше kMaxFileBytes не загружаются.
+     */
+    class StaticAssets
+    {
+    public:
+        static constexpr std::size_t kMaxFileBytes = 64 * 1024 * 1024;
+
+        explicit StaticAssets(std::string root);
+
+        /**
+         * @brief Перечитывает каталог; возвращает число загруженных файлов.
+         */
+        std::size_t reload();
+
+        /**
+         * @brief Файл по пути URL без ведущего '/' ("css/site.css"); пустой путь и путь на '/' - index.html.
+         * nullptr, если такого файла нет.
+         */
+        std::shared_ptr<const StaticAsset> find(std::string_view path) const;
+
+        const std::string& root() const { return root_; }
+
+    private:
+        using Snapshot = std::unordered_map<std::string, std::shared_ptr<const StaticAsset>>;
+
+        std::shared_ptr<const Snapshot> snapshot() const;
+
+        std::string root_;
+        mutable std::mutex mutex_;
+        std::shared_ptr<const Snapshot> snapshot_;
+    };
+
+    /**
+     * @brief MIME-тип по расширению файла (с charset=utf-8 для текстовых); неизвестные - application/octet-stream.
+     */
+    std::string_view mime_type(const std::filesystem::path& path);
+
+    /**
+     * @brief Сжимает данные в формат gzip с наибольшей степенью сжатия - варианты готовятся один раз при загрузке.
+     */
+    std::string gzip_compress(std::string_view data);
+}
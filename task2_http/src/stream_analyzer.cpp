@@ -0,0 +1,94 @@
+#include "stream_analyzer.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace geo
+{
+    StreamAnalyzer::StreamAnalyzer(Sink sink) : sink_(std::move(sink)) {
+        window_.reserve(kMaxLookbackBytes + kCarryBytes + kStepBytes);
+    }
+
+    void StreamAnalyzer::feed(std::string_view chunk) {
+        if (finished_) {
+            throw std::logic_error("StreamAnalyzer::feed after finish");
+        }
+        // Большая часть добавляется порциями, чтобы окно оставалось ограниченным
+        while (!chunk.empty()) {
+            const std::size_t take = std::min(chunk.size(), kStepBytes - pending_);
+            window_.append(chunk.data(), take);
+            chunk.remove_prefix(take);
+            pending_ += take;
+            if (pending_ == kStepBytes) {
+                process(false);
+            }
+        }
+    }
+
+    void StreamAnalyzer::finish() {
+        if (finished_) {
+            return;
+        }
+        process(true);
+        finished_ = true;
+
+        line_.clear();
+        JsonWriter writer(line_, false);
+        writer.begin_object();
+        writer.key("coordinate_type").value(classify_coordinates(count_, first_, last_));
+        writer.key("total_found").value(count_);
+        writer.end_object();
+        line_ += '\n';
+        sink_(line_);
+    }
+
+    void StreamAnalyzer::emit(const Coordinate& coord) {
+        line_.clear();
+        JsonWriter writer(line_, false);
+        write_coordinate_json(writer, coord);
+        line_ += '\n';
+        sink_(line_);
+        if (count_++ == 0) {
+            first_.lat_dd = coord.lat_dd;
+            first_.lon_dd = coord.lon_dd;
+        }
+        last_.lat_dd = coord.lat_dd;
+        last_.lon_dd = coord.lon_dd;
+    }
+
+    void StreamAnalyzer::process(bool final) {
+        pending_ = 0;
+        const std::string_view text = window_;
+        const DocumentIndex index(text);
+
+        // Шаг сканера с позиции до limit видит пару целиком (пара короче kCarryBytes), поэтому шаги
+        // продолжаются с позиции последовательного прохода и дают те же пары, что и сканирование всего текста
+        const std::size_t limit = final ? text.size() : text.size() - std::min(text.size(), kCarryBytes);
+        const std::size_t from = scan_pos_ - window_offset_;
+        if (from >= limit) {
+            return;
+        }
+        const SegmentScan scan = scan_segment(text, from, limit);
+        for (const CoordinateMatch& match : scan.matches) {
+            emit(make_coordinate(text, index, match));
+        }
+        scan_pos_ = window_offset_ + scan.exit;
+        if (final) {
+            return;
+        }
+
+        // Окно сдвигается к границе разреза перед позицией сканера (как у отрезков параллельного анализа),
+        // чтобы контекст и метка следующих пар, в том числе метка на предыдущей строке, совпадали с анализом всего текста
+        const std::size_t next = std::min(scan.exit, text.size());
+        std::size_t cut = split_point_before(text, next);
+        if (next > kMaxLookbackBytes && cut < next - kMaxLookbackBytes) {
+            cut = next - kMaxLookbackBytes;
+            while (cut < text.size() && (static_cast<unsigned char>(text[cut]) & 0xC0) == 0x80) {
+                ++cut;
+            }
+        }
+        window_.erase(0, cut);
+        window_offset_ += cut;
+    }
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+
+#include "geo_analyzer.hpp"
+
+namespace geo
+{
+    /**
+     * @brief Потоковый анализ текста произвольного размера с выводом NDJSON.
+     *
+     * Текст подаётся частями через feed(); в памяти держится только окно: текст от границы разреза
+     * (split_point_after) перед позицией сканера, но не более kMaxLookbackBytes, и хвост kCarryBytes,
+     * в котором пара ещё может продолжиться следующей частью. Сканирование продолжается с позиции
+     * последовательного прохода, а не с начала окна.
+     * Каждая подтверждённая координата сразу передаётся в sink строкой NDJSON - тем же объектом,
+     * что и элемент "coordinates" ответа analyze_geo_text. finish() дописывает последнюю строку
+     * {"coordinate_type": ..., "total_found": ...}.
+     *
+     * Результат совпадает с analyze_geo_text при любом делении на части для пар короче kCarryBytes
+     * и предложений короче kMaxLookbackBytes; у более длинных предложений контекст начинается с начала окна.
+     */
+    class StreamAnalyzer
+    {
+    public:
+        using Sink = std::function<void(std::string_view line)>;
+
+        static constexpr std::size_t kCarryBytes = 16 * 1024;           ///< Хвост окна, где пара считается неподтверждённой
+        static constexpr std::size_t kMaxLookbackBytes = 64 * 1024;     ///< Наибольшее начало предложения, сохраняемое в окне
+        static constexpr std::size_t kStepBytes = 64 * 1024;            ///< Окно анализируется после каждых kStepBytes новых байт
+
+        explicit StreamAnalyzer(Sink sink);
+
+        /**
+         * @brief Добавляет следующую часть текста; часть может обрываться посреди символа UTF-8.
+         */
+        void feed(std::string_view chunk);
+
+        /**
+         * @brief Анализирует остаток окна и выводит итоговую строку; после вызова feed() недопустим.
+         */
+        void finish();
+
+        std::size_t total_found() const { return count_; }
+
+    private:
+        void process(bool final);
+        void emit(const Coordinate& coord);
+
+        Sink sink_;
+        std::string window_;
+        std::string line_;                  ///< Буфер строки NDJSON, переиспользуется между строками
+        std::size_t window_offset_ = 0;     ///< Смещение window_[0] от начала потока
+        std::size_t scan_pos_ = 0;          ///< Смещение потока, с которого продолжается сканирование
+        std::size_t pending_ = 0;           ///< Байт добавлено с последнего анализа окна
+        std::size_t count_ = 0;
+        Coordinate first_;                  ///< Для классификации нужны только значения первой и последней точки
+        Coordinate last_;
+        bool finished_ = false;
+    };
+}
@@ -0,0 +1,126 @@
+#pragma once
+#include <cstddef>
+#include <string_view>
+
+// Минимальная поддержка UTF-8 для разбора текста: декодирование символа по смещению
+// и классы символов, нужные сканеру координат и индексу документа
+namespace geo::utf8
+{
+    struct CodePoint {
+        char32_t value = 0;
+        std::size_t length = 1;     ///< Длина в байтах; 1 для некорректной последовательности
+    };
+
+    /**
+     * @brief Декодирует символ, начинающийся в pos; некорректный байт даёт U+FFFD длиной 1.
+     *
+     * Корректность - по RFC 3629: избыточные записи (C0 A2, E0 80 80), суррогаты UTF-16 (ED A0 80),
+     * значения больше U+10FFFF (F4 90 80 80) и ведущие байты F5-FF некорректны.
+     */
+    inline CodePoint decode(std::string_view text, std::size_t pos) {
+        const auto b0 = static_cast<unsigned char>(text[pos]);
+        if (b0 < 0x80) {
+            return { b0, 1 };
+        }
+        // C0 и C1 дают только избыточные двухбайтовые записи, F5-FF - значения больше U+10FFFF
+        if (b0 < 0xC2 || b0 > 0xF4) {
+            return { 0xFFFD, 1 };
+        }
+        const std::size_t length = b0 >= 0xF0 ? 4 : b0 >= 0xE0 ? 3 : 2;
+        if (pos + length > text.size()) {
+            return { 0xFFFD, 1 };
+        }
+        // Диапазон второго байта после E0, ED, F0, F4 исключает избыточные записи, суррогаты и значения больше U+10FFFF
+        const auto b1 = static_cast<unsigned char>(text[pos + 1]);
+        const unsigned char low = b0 == 0xE0 ? 0xA0 : b0 == 0xF0 ? 0x90 : 0x80;
+        const unsigned char high = b0 == 0xED ? 0x9F : b0 == 0xF4 ? 0x8F : 0xBF;
+        if (b1 < low || b1 > high) {
+            return { 0xFFFD, 1 };
+        }
+        char32_t value = b0 & (0x3F >> (length - 1));
+        for (std::size_t i = 1; i < length; ++i) {
+            const auto b = static_cast<unsigned char>(text[pos + i]);
+            if ((b & 0xC0) != 0x80) {
+                return { 0xFFFD, 1 };
+            }
+            value = (value << 6) | (b & 0x3F);
+        }
+        return { value, length };
+    }
+
+    /**
+     * @brief Символ, заканчивающийся перед pos (0 в начале текста).
+     */
+    inline char32_t decode_before(std::string_view text, std::size_t pos) {
+        if (pos == 0) {
+            return 0;
+        }
+        std::size_t start = pos - 1;
+        while (start > 0 && pos - start < 4 && (static_cast<unsigned char>(text[start]) & 0xC0) == 0x80) {
+            --start;
+        }
+        const CodePoint cp = decode(text, start);
+        return start + cp.length == pos ? cp.value : 0xFFFD;
+    }
+
+    inline bool is_digit(char32_t c) { return c >= '0' && c <= '9'; }
+
+    // Латиница (в том числе с диакритикой), греческий, кириллица
+    inline bool is_letter(char32_t c) {
+        if (c < 0x80) {
+            return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+        }
+        return (c >= 0xC0 && c <= 0x24F && c != 0xD7 && c != 0xF7) || (c >= 0x370 && c <= 0x52F);
+    }
+
+    inline bool is_upper(char32_t c) {
+        return (c >= 'A' && c <= 'Z') || (c >= 0x410 && c <= 0x42F) || c == 0x401;
+    }
+
+    inline bool is_space(char32_t c) {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f'
+            || c == 0xA0 || c == 0x2007 || c == 0x2009 || c == 0x202F;
+    }
+
+    /**
+     * @brief Смещение после последнего непробельного символа в [begin, end).
+     */
+    inline std::size_t trim_back(std::string_view text, std::size_t begin, std::size_t end) {
+        while (end > begin && is_space(decode_before(text, end))) {
+            --end;
+            while (end > begin && (static_cast<unsigned char>(text[end]) & 0xC0) == 0x80) {
+                --end;
+            }
+        }
+        return end;
+    }
+
+    // Нижний регистр для латиницы и кириллицы
+    inline char32_t fold(char32_t c) {
+        if (c >= 'A' && c <= 'Z') return c + 0x20;
+        if (c >= 0x410 && c <= 0x42F) return c + 0x20;
+        if (c == 0x401) return 0x451;
+        return c;
+    }
+
+    /**
+     * @brief Начинается ли text с pos с основы stem (строчные буквы) без учёта регистра; end - позиция за основой.
+     */
+    inline bool starts_with_folded(std::string_view text, std::size_t pos, std::string_view stem, std::size_t& end) {
+        std::size_t s = 0;
+        while (s < stem.size()) {
+            if (pos >= text.size()) {
+                return false;
+            }
+            const CodePoint expected = decode(stem, s);
+            const CodePoint actual = decode(text, pos);
+            if (fold(actual.value) != expected.value) {
+                return false;
+            }
+            s += expected.length;
+            pos += actual.length;
+        }
+        end = pos;
+        return true;
+    }
+}
@@ -0,0 +1,84 @@
+#include "worker_pool.hpp"
+#include <algorithm>
+#include <exception>
+#include <utility>
+
+namespace geo
+{
+    WorkerPool::WorkerPool(std::size_t threads) {
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        threads_.reserve(threads);
+        for (std::size_t i = 0; i < threads; ++i) {
+            threads_.emplace_back([this] { worker_loop(); });
+        }
+    }
+
+    WorkerPool::~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        ready_.notify_all();
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+    }
+
+    void WorkerPool::submit(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tasks_.push_back(std::move(task));
+        }
+        ready_.notify_one();
+    }
+
+    void WorkerPool::run_and_wait(std::vector<std::function<void()>> tasks) {
+        std::mutex mutex;
+        std::condition_variable done;
+        std::size_t left = tasks.size();
+        std::exception_ptr error;
+
+        for (auto& task : tasks) {
+            submit([&, task = std::move(task)] {
+                std::exception_ptr task_error;
+                try {
+                    task();
+                }
+                catch (...) {
+                    task_error = std::current_exception();
+                }
+                std::lock_guard<std::mutex> lock(mutex);
+                if (task_error && !error) {
+                    error = task_error;
+                }
+                if (--left == 0) {
+                    done.notify_all();
+                }
+            });
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [&] { return left == 0; });
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    void WorkerPool::worker_loop() {
+        for (;;) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                ready_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+                if (tasks_.empty()) {
+                    return;
+                }
+                task = std::move(tasks_.front());
+                tasks_.pop_front();
+            }
+            task();
+        }
+    }
+}
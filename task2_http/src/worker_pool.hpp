@@ -0,0 +1,49 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace geo
+{
+    /**
+     * @brief Пул потоков для анализа текста: фиксированное число потоков и общая очередь задач.
+     *
+     * Отделён от потоков Crow: пакетный анализ занимает только свои потоки, а потоки сервера
+     * продолжают принимать запросы. Деструктор дожидается выполнения уже поставленных задач.
+     */
+    class WorkerPool
+    {
+    public:
+        /**
+         * @param threads Число потоков; 0 - по числу ядер.
+         */
+        explicit WorkerPool(std::size_t threads = 0);
+        ~WorkerPool();
+
+        WorkerPool(const WorkerPool&) = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+
+        void submit(std::function<void()> task);
+
+        /**
+         * @brief Выполняет задачи на пуле и ждёт завершения всех; первое исключение задачи пробрасывается.
+         * Нельзя вызывать из потока самого пула: ожидающий поток занял бы место исполнителя.
+         */
+        void run_and_wait(std::vector<std::function<void()>> tasks);
+
+        std::size_t size() const { return threads_.size(); }
+
+    private:
+        void worker_loop();
+
+        std::mutex mutex_;
+        std::condition_variable ready_;
+        std::deque<std::function<void()>> tasks_;
+        bool stop_ = false;
+        std::vector<std::thread> threads_;
+    };
+}
@@ -0,0 +1,67 @@
+// scan_coordinates на записях, которые принимала прежняя реализация на регулярном выражении: полушарие
+// через пробел после числа, за которым идёт следующий компонент со своим полушарием ("55.75 N 37.61 E"),
+// а также соседние записи, разбор которых от этого не должен меняться.
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "coord_scanner.hpp"
+
+namespace
+{
+    int failures = 0;
+
+    struct Case {
+        std::string_view text;
+        std::size_t pairs;
+        double lat = 0.0;       // первая пара
+        double lon = 0.0;
+    };
+
+    void expect(const Case& c) {
+        const std::vector<geo::CoordinateMatch> matches = geo::scan_coordinates(c.text);
+        if (matches.size() != c.pairs) {
+            std::cerr << "\"" << c.text << "\": " << matches.size() << " pair(s), expected " << c.pairs << std::endl;
+            ++failures;
+            return;
+        }
+        if (c.pairs > 0 && (std::abs(matches[0].lat_dd - c.lat) > 1e-6 || std::abs(matches[0].lon_dd - c.lon) > 1e-6)) {
+            std::cerr << "\"" << c.text << "\": got (" << matches[0].lat_dd << ", " << matches[0].lon_dd << "), expected ("
+                << c.lat << ", " << c.lon << ")" << std::endl;
+            ++failures;
+        }
+    }
+}
+
+int main() {
+    const Case cases[] = {
+        // Полушарие через пробел, следующий компонент со своим суффиксом
+        { "55.75 N 37.61 E", 1, 55.75, 37.61 },
+        { "51\xC2\xB0" "12.32' S 32\xC2\xB0" "34.43' E", 1, -(51 + 12.32 / 60), 32 + 34.43 / 60 },
+        { "Point: 40.7128 N 74.0060 W, done", 1, 40.7128, -74.0060 },
+        { "12.5 E 55.75 N", 1, 55.75, 12.5 },
+
+        // Прежние записи: приставки, суффиксы вплотную и через пробел перед разделителем
+        { "N55.75, E37.61", 1, 55.75, 37.61 },
+        { "N55.75 E37.61", 1, 55.75, 37.61 },
+        { "55.75N 37.61E", 1, 55.75, 37.61 },
+        { "55.75 N, 37.61 E", 1, 55.75, 37.61 },
+        { "55.75, 37.61", 1, 55.75, 37.61 },
+
+        // Буква без суффикса у следующего компонента остаётся его приставкой
+        { "10.5, 20.5 N30.5 E40.5", 2, 10.5, 20.5 },
+        { "55.75 N 37.61", 0 },
+    };
+    for (const Case& c : cases) {
+        expect(c);
+    }
+
+    if (failures > 0) {
+        std::cerr << failures << " failures" << std::endl;
+        return 1;
+    }
+    std::cout << "coord_scanner_test: OK" << std::endl;
+    return 0;
+}
@@ -0,0 +1,99 @@
+// JsonWriter против nlohmann::json: строки с некорректным UTF-8 (RFC 3629) должны давать корректный JSON,
+// в котором каждый некорректный байт заменён на U+FFFD, а корректные символы сохранены как есть.
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+
+#include <nlohmann/json.hpp>
+
+#include "json_writer.hpp"
+
+namespace
+{
+    const std::string kReplacement = "\xEF\xBF\xBD";
+
+    int failures = 0;
+
+    // Строка text, записанная как {"s": text} и разобранная nlohmann
+    bool round_trip(const std::string& text, std::string& parsed) {
+        std::string out;
+        geo::JsonWriter writer(out, false);
+        writer.begin_object();
+        writer.key("s").value(std::string_view(text));
+        writer.end_object();
+        try {
+            parsed = nlohmann::json::parse(out).at("s").get<std::string>();
+            return true;
+        }
+        catch (const nlohmann::json::exception& e) {
+            std::cerr << "writer output rejected by nlohmann: " << e.what() << std::endl;
+            return false;
+        }
+    }
+
+    void expect(const std::string& name, const std::string& input, const std::string& expected) {
+        std::string parsed;
+        if (!round_trip(input, parsed)) {
+            std::cerr << "  case " << name << std::endl;
+            ++failures;
+        }
+        else if (parsed != expected) {
+            std::cerr << "case " << name << ": unexpected value after round trip" << std::endl;
+            ++failures;
+        }
+    }
+
+    std::string repeat_replacement(int count) {
+        std::string out;
+        for (int i = 0; i < count; ++i) {
+            out += kReplacement;
+        }
+        return out;
+    }
+}
+
+int main() {
+    // Некорректные последовательности: каждый байт заменяется отдельно
+    expect("overlong C0 A2", "a\xC0\xA2z", "a" + repeat_replacement(2) + "z");
+    expect("overlong C1 BF", "a\xC1\xBFz", "a" + repeat_replacement(2) + "z");
+    expect("overlong E0 80 80", "a\xE0\x80\x80z", "a" + repeat_replacement(3) + "z");
+    expect("overlong F0 80 80 80", "a\xF0\x80\x80\x80z", "a" + repeat_replacement(4) + "z");
+    expect("surrogate ED A0 80", "a\xED\xA0\x80z", "a" + repeat_replacement(3) + "z");
+    expect("surrogate ED BF BF", "a\xED\xBF\xBFz", "a" + repeat_replacement(3) + "z");
+    expect("above U+10FFFF F4 90 80 80", "a\xF4\x90\x80\x80z", "a" + repeat_replacement(4) + "z");
+    expect("lead F5", "a\xF5\x80\x80\x80z", "a" + repeat_replacement(4) + "z");
+    expect("lead F8", "a\xF8\x88\x80\x80z", "a" + repeat_replacement(4) + "z");
+    expect("lead FF", "a\xFFz", "a" + kReplacement + "z");
+    expect("lone continuation", "a\x80z", "a" + kReplacement + "z");
+    expect("truncated at end", "a\xE2\x82", "a" + repeat_replacement(2));
+    expect("truncated before ASCII", "\xD0z", kReplacement + "z");
+
+    // Граничные корректные символы сохраняются без изменений
+    for (const char* valid : { "\x7F", "\xC2\x80", "\xDF\xBF", "\xE0\xA0\x80", "\xED\x9F\xBF", "\xEE\x80\x80",
+        "\xEF\xBF\xBF", "\xF0\x90\x80\x80", "\xF4\x8F\xBF\xBF", "\xD0\x9C\xD0\xBE\xD1\x81\xD0\xBA\xD0\xB2\xD0\xB0" }) {
+        expect("valid", std::string("<") + valid + ">", std::string("<") + valid + ">");
+    }
+    expect("escapes", "\"\\\b\f\n\r\t\x01\x1F", "\"\\\b\f\n\r\t\x01\x1F");
+
+    // Случайные байты: вывод всегда разбирается
+    std::mt19937 rng(42);
+    for (int i = 0; i < 20000; ++i) {
+        std::string text(rng() % 16, '\0');
+        for (char& c : text) {
+            c = static_cast<char>(rng() % 4 == 0 ? rng() % 0x80 : 0x80 + rng() % 0x80);
+        }
+        std::string parsed;
+        if (!round_trip(text, parsed)) {
+            ++failures;
+            break;
+        }
+    }
+
+    if (failures > 0) {
+        std::cerr << failures << " failures" << std::endl;
+        return 1;
+    }
+    std::cout << "json_writer_test: OK" << std::endl;
+    return 0;
+}
@@ -0,0 +1,89 @@
+// Потоковый анализ против analyze_geo_text: метка на строке перед координатой ("Label:\n<пара>")
+// и пара с переносом строки между широтой и долготой у границы подтверждения окна
+// (kStepBytes - kCarryBytes = 48 КиБ) при разном делении текста на части.
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include "geo_analyzer.hpp"
+#include "stream_analyzer.hpp"
+
+namespace
+{
+    std::string serial_ndjson(const std::string& text) {
+        const geo::GeoAnalysis analysis = geo::analyze_geo_text(text);
+        std::string out;
+        for (const geo::Coordinate& coord : analysis.coordinates) {
+            geo::JsonWriter writer(out, false);
+            geo::write_coordinate_json(writer, coord);
+            out += '\n';
+        }
+        geo::JsonWriter writer(out, false);
+        writer.begin_object();
+        writer.key("coordinate_type").value(analysis.coordinate_type);
+        writer.key("total_found").value(analysis.coordinates.size());
+        writer.end_object();
+        out += '\n';
+        return out;
+    }
+
+    std::string stream_ndjson(std::string_view text, size_t chunk) {
+        std::string out;
+        geo::StreamAnalyzer analyzer([&](std::string_view line) { out += line; });
+        for (size_t pos = 0; pos < text.size(); pos += chunk) {
+            analyzer.feed(text.substr(pos, chunk));
+        }
+        analyzer.finish();
+        return out;
+    }
+}
+
+int main() {
+    const size_t limit = geo::StreamAnalyzer::kStepBytes - geo::StreamAnalyzer::kCarryBytes;
+    const std::string filler = "Filler text without numbers goes here. ";
+    const std::string tails[] = {
+        "Point Alpha:\nN39.7591 W104.9920\nEnd of route.",
+        "Point Alpha:\n\nN39.7591\nW104.9920 and more text.",
+        "Точка B -\n55.7558,\n37.6173. Конец.",
+    };
+
+    int failures = 0;
+    for (const std::string& tail : tails) {
+        // Начало метки от 64 байт до границы до 32 байт после неё
+        for (size_t offset = limit - 64; offset <= limit + 32; offset += 4) {
+            std::string text;
+            while (text.size() + filler.size() <= offset) {
+                text += filler;
+            }
+            text.append(offset - text.size(), ' ');
+            text += tail;
+            // Окно анализируется только после kStepBytes новых байт - текст продолжается дальше
+            while (text.size() < 2 * geo::StreamAnalyzer::kStepBytes) {
+                text += ' ';
+                text += filler;
+            }
+
+            const std::string expected = serial_ndjson(text);
+            if (expected.find("\"label\":\"\xD0\x9D\xD0\xB5\xD1\x82\"") != std::string::npos) {    // Нет
+                std::cerr << "serial analysis lost the label at offset " << offset << std::endl;
+                ++failures;
+            }
+            for (size_t chunk : { text.size(), size_t(1), size_t(1000), size_t(40000) }) {
+                const std::string actual = stream_ndjson(text, chunk);
+                if (actual != expected) {
+                    std::cerr << "offset " << offset << " chunk " << chunk << ":\n  expected " << expected
+                        << "  actual   " << actual << std::endl;
+                    ++failures;
+                }
+            }
+        }
+    }
+
+    if (failures > 0) {
+        std::cerr << failures << " mismatches" << std::endl;
+        return 1;
+    }
+    std::cout << "stream_analyzer_test: OK" << std::endl;
+    return 0;
+}
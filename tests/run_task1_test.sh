@@ -34,11 +34,13 @@ echo "▶ Using binary: $APP_BIN"
 SERVER_PID=$!
 sleep 1
 
-# Запуск клиента (ограничиваемся только первым блоком с "Sorted Student List")
-OUTPUT=$("$APP_BIN" -m client -u 127.0.0.1:5555 | awk '
-  /Sorted Student List/ {capture=1}
+# Запуск клиента: --once завершает его после первого списка, timeout - страховка от зависания.
+# awk дочитывает вывод до конца (без exit), чтобы клиент не получил SIGPIPE;
+# сохраняется только первый блок с "Sorted Student List"
+OUTPUT=$(timeout 60 "$APP_BIN" -m client -u 127.0.0.1:5555 --once | awk '
+  /Sorted Student List/ && !done {capture=1}
   capture {print}
-  /=======================================================/ && capture && ++count==2 {exit}
+  /=======================================================/ && capture && ++count==2 {capture=0; done=1}
 ')
 
 # Остановка сервера